@@ -13,4 +13,12 @@ else()
         -Wsign-conversion
         -Wshadow
     )
-endif()
\ No newline at end of file
+endif()
+
+# Baseline ISA for all code. Empty keeps the compiler default, which runs on
+# any host of the architecture; the kernels behind aoc::select_kernel carry
+# their own AVX2/AVX-512 versions either way.
+set(AOC_MARCH "" CACHE STRING "-march value for every target (e.g. native, x86-64-v3); empty = compiler default")
+if (AOC_MARCH AND NOT MSVC)
+    target_compile_options(aoc_compile_options INTERFACE -march=${AOC_MARCH})
+endif()
@@ -1,33 +1,135 @@
 #pragma once
 
+#include "aoc/alloc.hpp"
+#include "aoc/log.hpp"
+#include "aoc/perf.hpp"
+#include "aoc/scan.hpp"
+#include "aoc/trace.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cctype>
 #include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace aoc {
 
-inline std::vector<std::string> read_lines(const std::filesystem::path &path) {
-    std::ifstream in(path);
-    if (!in) {
-        throw std::runtime_error("Failed to open input file: " + path.string());
+// Read-only view of an input file. The file is memory-mapped and split into
+// a line index of string_views pointing straight into the mapping, so no
+// per-line allocation happens. Lines follow std::getline semantics: a trailing
+// '\n' does not produce an extra empty line and a trailing '\r' is dropped.
+class MappedInput {
+public:
+    explicit MappedInput(const std::filesystem::path &path) {
+#if defined(_WIN32)
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            throw std::runtime_error("Failed to open input file: " + path.string());
+        }
+        fallback_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        data_ = fallback_.data();
+        size_ = fallback_.size();
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Failed to open input file: " + path.string());
+        }
+        struct stat st{};
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Failed to stat input file: " + path.string());
+        }
+        size_ = static_cast<std::size_t>(st.st_size);
+        if (size_ > 0) {
+            void *addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Failed to map input file: " + path.string());
+            }
+            ::madvise(addr, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const char *>(addr);
+        }
+        ::close(fd);
+#endif
+        index_lines();
+    }
+
+    MappedInput(const MappedInput &) = delete;
+    MappedInput &operator=(const MappedInput &) = delete;
+
+    ~MappedInput() {
+#if !defined(_WIN32)
+        if (size_ > 0) {
+            ::munmap(const_cast<char *>(data_), size_);
+        }
+#endif
     }
-    std::vector<std::string> lines;
-    std::string line;
-    while (std::getline(in, line)) {
+
+    [[nodiscard]] std::string_view text() const noexcept { return {data_, size_}; }
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] std::span<const std::string_view> lines() const noexcept { return lines_; }
+
+private:
+    void index_lines() {
+        // Offsets from the scanner are 32-bit, so index huge files in chunks.
+        constexpr std::size_t chunk = std::size_t{1} << 31;
+        DelimiterOffsets offsets;
+        std::size_t line_start = 0;
+        for (std::size_t base = 0; base < size_; base += chunk) {
+            scan_delimiters(text().substr(base, chunk), newline, offsets);
+            for (const auto nl : offsets.lines) {
+                push_line(line_start, base + nl);
+                line_start = base + nl + 1;
+            }
+        }
+        if (line_start < size_) {
+            push_line(line_start, size_);
+        }
+    }
+
+    void push_line(std::size_t begin, std::size_t end) {
+        std::string_view line{data_ + begin, end - begin};
         if (!line.empty() && line.back() == '\r') {
-            line.pop_back();
+            line.remove_suffix(1);
         }
-        lines.push_back(std::move(line));
+        lines_.push_back(line);
     }
-    return lines;
-}
 
-inline std::string trim(std::string_view sv) {
+    const char *data_{nullptr};
+    std::size_t size_{0};
+    std::vector<std::string_view> lines_;
+#if defined(_WIN32)
+    std::string fallback_;
+#endif
+};
+
+// What every solve_part1/solve_part2 receives: a view over the line index.
+using Lines = std::span<const std::string_view>;
+
+inline std::string_view trim(std::string_view sv) {
     std::size_t start = 0;
     while (start < sv.size() && std::isspace(static_cast<unsigned char>(sv[start]))) {
         ++start;
@@ -36,17 +138,319 @@ inline std::string trim(std::string_view sv) {
     while (end > start && std::isspace(static_cast<unsigned char>(sv[end - 1]))) {
         --end;
     }
-    return std::string(sv.substr(start, end - start));
+    return sv.substr(start, end - start);
+}
+
+// Checked 64-bit arithmetic: out = a * b (or a + b), wrapping; true when the
+// exact result does not fit. Compiler builtins where available, a division
+// check elsewhere (MSVC).
+constexpr bool mul_overflow(std::uint64_t a, std::uint64_t b, std::uint64_t &out) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_mul_overflow(a, b, &out);
+#else
+    out = a * b;
+    return a != 0 && out / a != b;
+#endif
+}
+
+constexpr bool add_overflow(std::uint64_t a, std::uint64_t b, std::uint64_t &out) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_add_overflow(a, b, &out);
+#else
+    out = a + b;
+    return out < a;
+#endif
 }
 
-// Tiny timing helper
+namespace detail {
+
+inline constexpr std::array<std::uint64_t, 9> pow10_u64{
+    1ULL, 10ULL, 100ULL, 1'000ULL, 10'000ULL, 100'000ULL,
+    1'000'000ULL, 10'000'000ULL, 100'000'000ULL,
+};
+
+// Per byte of `chunk`: zero when the byte is an ASCII digit, non-zero otherwise.
+// A carry out of a non-digit byte can only disturb the bytes after it, which
+// callers never look at because they stop at the first non-digit.
+[[nodiscard]]
+constexpr std::uint64_t swar_non_digits(std::uint64_t chunk) noexcept {
+    constexpr std::uint64_t high = 0xF0F0F0F0F0F0F0F0ULL;
+    constexpr std::uint64_t zeros = 0x3030303030303030ULL;
+    constexpr std::uint64_t sixes = 0x0606060606060606ULL;
+    return ((chunk & high) ^ zeros) | (((chunk + sixes) & high) ^ zeros);
+}
+
+// Value of 8 ASCII digits loaded little-endian (first digit in the low byte).
+[[nodiscard]]
+constexpr std::uint64_t swar_parse8(std::uint64_t chunk) noexcept {
+    chunk -= 0x3030303030303030ULL;
+    chunk = (chunk * 10) + (chunk >> 8);
+    chunk = (((chunk & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+             (((chunk >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+    return chunk;
+}
+
+}  // namespace detail
+
+// Cursor over a piece of text for allocation-free parsing. Integers are read
+// eight digits at a time with SWAR arithmetic whenever eight bytes are left in
+// the view; shorter tails fall back to a digit loop. Errors throw
+// std::runtime_error like the rest of the helpers.
+class Scanner {
+public:
+    constexpr explicit Scanner(std::string_view text) noexcept : text_(text) {}
+
+    [[nodiscard]] constexpr bool done() const noexcept { return pos_ >= text_.size(); }
+    [[nodiscard]] constexpr std::size_t pos() const noexcept { return pos_; }
+    [[nodiscard]] constexpr std::string_view rest() const noexcept { return text_.substr(pos_); }
+    [[nodiscard]] constexpr char peek() const noexcept { return done() ? '\0' : text_[pos_]; }
+
+    constexpr void advance(std::size_t n = 1) noexcept { pos_ = std::min(pos_ + n, text_.size()); }
+
+    constexpr void skip_spaces() noexcept {
+        while (!done() && (text_[pos_] == ' ' || text_[pos_] == '\t' ||
+                           text_[pos_] == '\r' || text_[pos_] == '\n')) {
+            ++pos_;
+        }
+    }
+
+    // Move to the next occurrence of c (or the end) without consuming it.
+    constexpr void skip_until(char c) noexcept {
+        const auto at = text_.find(c, pos_);
+        pos_ = at == std::string_view::npos ? text_.size() : at;
+    }
+
+    // Consume c if it is next; report whether it was.
+    constexpr bool consume(char c) noexcept {
+        if (!done() && text_[pos_] == c) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    void expect(char c) {
+        if (!consume(c)) {
+            throw std::runtime_error("expected '" + std::string(1, c) + "' at: '" + std::string(rest()) + "'");
+        }
+    }
+
+    void expect_end() {
+        if (!done()) {
+            throw std::runtime_error("unexpected trailing input: '" + std::string(rest()) + "'");
+        }
+    }
+
+    // Next integer after optional spaces; signed types accept a leading '-'.
+    template <std::integral T>
+    T next() {
+        skip_spaces();
+        const std::size_t start = pos_;
+        bool negative = false;
+        if constexpr (std::is_signed_v<T>) {
+            negative = consume('-');
+        }
+
+        std::uint64_t magnitude{};
+        if (!read_digits(magnitude)) {
+            pos_ = start;
+            throw std::runtime_error("invalid integer at: '" + std::string(rest()) + "'");
+        }
+
+        using U = std::make_unsigned_t<T>;
+        const auto limit = static_cast<std::uint64_t>(std::numeric_limits<U>::max() >> (std::is_signed_v<T> ? 1 : 0));
+        if (magnitude > limit + (negative ? 1U : 0U)) {
+            throw std::runtime_error("integer out of range: '" + std::string(text_.substr(start, pos_ - start)) + "'");
+        }
+        if (negative) {
+            return static_cast<T>(static_cast<U>(std::uint64_t{0} - magnitude));
+        }
+        return static_cast<T>(magnitude);
+    }
+
+    std::uint32_t next_u32() { return next<std::uint32_t>(); }
+    std::uint64_t next_u64() { return next<std::uint64_t>(); }
+    std::int64_t next_i64() { return next<std::int64_t>(); }
+
+private:
+    // Accumulate the digit run at the cursor; false if there is none or it overflows.
+    bool read_digits(std::uint64_t &acc) noexcept {
+        const std::size_t start = pos_;
+        acc = 0;
+        if constexpr (std::endian::native == std::endian::little) {
+            while (pos_ + 8 <= text_.size()) {
+                std::uint64_t chunk;
+                std::memcpy(&chunk, text_.data() + pos_, sizeof(chunk));
+                const std::uint64_t bad = detail::swar_non_digits(chunk);
+                const auto n = static_cast<unsigned>(std::countr_zero(bad)) / 8;  // 8 if all digits
+                if (n == 0) {
+                    break;
+                }
+                // Left-align the n digits and pad the low bytes with '0's so
+                // the number reads as eight digits with leading zeros.
+                const unsigned shift = 8 * (8 - n);
+                if (shift != 0) {
+                    chunk = (chunk << shift) | (0x3030303030303030ULL >> (64 - shift));
+                }
+                if (mul_overflow(acc, detail::pow10_u64[n], acc) ||
+                    add_overflow(acc, detail::swar_parse8(chunk), acc)) {
+                    return false;
+                }
+                pos_ += n;
+                if (n < 8) {
+                    return true;
+                }
+            }
+        }
+        while (!done() && text_[pos_] >= '0' && text_[pos_] <= '9') {
+            const auto digit = static_cast<std::uint64_t>(text_[pos_] - '0');
+            if (mul_overflow(acc, std::uint64_t{10}, acc) || add_overflow(acc, digit, acc)) {
+                return false;
+            }
+            ++pos_;
+        }
+        return pos_ != start;
+    }
+
+    std::string_view text_;
+    std::size_t pos_{0};
+};
+
+// Parse a whole field (surrounding spaces allowed) as an integer of type T.
+template <std::integral T>
+T parse(std::string_view sv) {
+    Scanner sc{sv};
+    const T value = sc.next<T>();
+    sc.skip_spaces();
+    if (!sc.done()) {
+        throw std::runtime_error("invalid integer: '" + std::string(sv) + "'");
+    }
+    return value;
+}
+
+// How results are written: human text, or one record per stage as JSON / CSV.
+enum class OutputFormat { text, json, csv };
+
+// Harness settings shared by every day binary. Filled by init() from the
+// command line and the environment; defaults keep the old single-run output.
+struct Options {
+    std::size_t bench_runs{0};     // --bench[=N] / AOC_BENCH=N; 0 = single run
+    std::size_t warmup_runs{3};    // --warmup=N / AOC_WARMUP=N
+    bool perf{false};              // --perf / AOC_PERF=1: hardware counters per part
+    std::size_t input_bytes{0};    // size of the loaded input, for per-byte ratios
+    std::string trace_path{"aoc_trace.json"};  // --trace=FILE / AOC_TRACE_FILE (AOC_TRACE builds)
+    std::size_t threads{0};        // --threads=N / AOC_THREADS=N; 0 = one per hardware thread
+    bool pin{false};               // --pin / AOC_PIN=1: pin pool threads to CPUs
+    OutputFormat format{OutputFormat::text};  // --format=text|json|csv / AOC_FORMAT
+    std::string model_cache;       // --model-cache[=DIR] / AOC_MODEL_CACHE=DIR: parsed-model cache; empty = off
+    std::string answer_cache;      // --answer-cache[=DIR] / AOC_ANSWER_CACHE=DIR: answers by input hash; empty = off
+    bool no_cache{false};          // --no-cache: ignore both caches for this run
+    bool verify_cache{false};      // --verify-cache: solve anyway and fail on a cached answer that differs
+    std::string isa;               // --isa=NAME / AOC_ISA=NAME: cap dispatched kernels (scalar..avx512); empty = best
+    LogLevel log_level{LogLevel::warn};  // --log=LEVEL / AOC_LOG=LEVEL: most verbose AOC_LOG level printed
+    std::size_t in_flight{0};      // --in-flight=N / AOC_IN_FLIGHT=N: batch inputs open at once; 0 = 2 per thread
+    bool stream{false};            // --stream / AOC_STREAM=1: read the input as a stream even when it is a file
+    std::size_t stream_every{0};   // --every=N / AOC_STREAM_EVERY=N: streaming, print running answers every N lines
+};
+
+Options &options() noexcept;
+
+// Parse and strip the harness flags so argv only keeps the day's own
+// arguments (e.g. the input path). Throws on unknown "--" options.
+void init(int &argc, char **argv);
+
+// Keep `value` alive as far as the optimizer is concerned.
+template <typename T>
+inline void do_not_optimize(const T &value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static_cast<void>(*static_cast<const volatile char *>(static_cast<const volatile void *>(&value)));
+#endif
+}
+
+// Distribution of the timed repetitions in benchmark mode, in nanoseconds.
+struct BenchStats {
+    std::size_t runs{0};
+    long long min_ns{0};
+    long long median_ns{0};
+    long long mean_ns{0};
+    long long p99_ns{0};
+    double stddev_ns{0.0};
+};
+
+BenchStats summarize(std::vector<long long> samples_ns);
+
+struct Timing {
+    long long micros{0};             // single run, or the median in benchmark mode
+    std::optional<BenchStats> bench;
+    std::optional<PerfCounters> perf; // per run, when --perf is on and allowed
+    std::optional<AllocStats> alloc;  // per run, when built with AOC_ALLOC_STATS
+};
+
+// Tiny timing helper. In benchmark mode f() runs warmup_runs times untimed
+// and then bench_runs times timed; the last result is returned. With --perf
+// the hardware counters cover the timed runs only, and so does allocation
+// accounting when it is compiled in.
 template <typename F>
 auto time_it(F &&f) {
-    auto start = std::chrono::steady_clock::now();
+    using clock = std::chrono::steady_clock;
+    const auto &opts = options();
+    PerfSession *perf = opts.perf ? &PerfSession::thread_local_instance() : nullptr;
+
+    std::optional<AllocStats> allocs;
+
+    if (opts.bench_runs == 0) {
+#if defined(AOC_ALLOC_STATS)
+        const AllocScope alloc_scope;
+#endif
+        if (perf) {
+            perf->start();
+        }
+        auto start = clock::now();
+        auto result = f();
+        auto end = clock::now();
+        auto counters = perf ? perf->stop() : std::nullopt;
+#if defined(AOC_ALLOC_STATS)
+        allocs = alloc_scope.stop();
+#endif
+        auto ms = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+        return std::pair{std::move(result), Timing{ms, std::nullopt, counters, allocs}};
+    }
+
+    for (std::size_t i = 0; i < opts.warmup_runs; ++i) {
+        do_not_optimize(f());
+    }
+
+    std::vector<long long> samples;
+    samples.reserve(opts.bench_runs);
     auto result = f();
-    auto end = std::chrono::steady_clock::now();
-    auto ms = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
-    return std::pair{result, ms};
+#if defined(AOC_ALLOC_STATS)
+    const AllocScope alloc_scope;
+#endif
+    if (perf) {
+        perf->start();
+    }
+    for (std::size_t i = 0; i < opts.bench_runs; ++i) {
+        auto start = clock::now();
+        result = f();
+        do_not_optimize(result);
+        auto end = clock::now();
+        samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+
+    auto counters = perf ? perf->stop() : std::nullopt;
+    if (counters) {
+        counters->divide(opts.bench_runs);
+    }
+#if defined(AOC_ALLOC_STATS)
+    allocs = alloc_scope.stop();
+    allocs->allocations /= opts.bench_runs;
+    allocs->bytes /= opts.bench_runs;
+#endif
+
+    auto stats = summarize(std::move(samples));
+    return std::pair{std::move(result), Timing{stats.median_ns / 1000, stats, counters, allocs}};
 }
 
 inline void print_answer(int part, const auto &answer, long long micros) {
@@ -54,4 +458,14 @@ inline void print_answer(int part, const auto &answer, long long micros) {
               << " (" << micros << " us)\n";
 }
 
-}  // namespace aoc
\ No newline at end of file
+void print_bench(const BenchStats &stats);
+
+// Benchmark, counter and allocation lines that follow an answer.
+void print_details(const Timing &timing);
+
+inline void print_answer(int part, const auto &answer, const Timing &timing) {
+    print_answer(part, answer, timing.micros);
+    print_details(timing);
+}
+
+}  // namespace aoc
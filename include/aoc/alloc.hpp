@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+
+namespace aoc {
+
+// Heap activity inside one timed region.
+struct AllocStats {
+    std::uint64_t allocations{0};
+    std::uint64_t bytes{0};       // requested bytes
+    std::uint64_t peak_bytes{0};  // peak live bytes above the level at scope start
+};
+
+// Global operator new/delete counters. They only move when aoc_common is
+// built with AOC_ALLOC_STATS=ON, which links alloc_stats.cpp and its
+// replacement operators; otherwise the harness never asks for them.
+struct AllocCounters {
+    std::uint64_t allocations{0};
+    std::uint64_t bytes{0};
+    std::uint64_t live_bytes{0};
+    std::uint64_t peak_live_bytes{0};
+};
+
+AllocCounters alloc_counters() noexcept;
+
+// Restart peak tracking from the current live level.
+void reset_alloc_peak() noexcept;
+
+// Snapshot on construction; stop() reports what happened since.
+class AllocScope {
+public:
+    AllocScope() noexcept : start_((reset_alloc_peak(), alloc_counters())) {}
+
+    [[nodiscard]] AllocStats stop() const noexcept {
+        const auto now = alloc_counters();
+        return AllocStats{
+            .allocations = now.allocations - start_.allocations,
+            .bytes = now.bytes - start_.bytes,
+            .peak_bytes = now.peak_live_bytes > start_.live_bytes ? now.peak_live_bytes - start_.live_bytes : 0,
+        };
+    }
+
+private:
+    AllocCounters start_;
+};
+
+void print_alloc(const AllocStats &stats);
+
+}  // namespace aoc
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "aoc.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace aoc {
+
+// Everything an answer depends on besides the part: the day, the solver's
+// own version, the build that produced it and the input content.
+struct AnswerKey {
+    int day{0};
+    std::uint32_t solver_version{0};
+    std::uint64_t build{0};
+    std::uint64_t input_hash{0};
+};
+
+// FNV-1a of the running executable's file, read on the first call; this is
+// AnswerKey::build. Any change to the linked code, whether a day or the
+// shared library, changes the binary and so invalidates its answers. Nothing
+// when the executable cannot be read.
+std::optional<std::uint64_t> binary_id() noexcept;
+
+// True when --answer-cache / AOC_ANSWER_CACHE is on, --no-cache is not and
+// the binary could be identified (a warning says so when it could not).
+bool answer_cache_enabled() noexcept;
+
+// The stored answer for one part, or nothing when there is no entry or it
+// does not carry exactly this key.
+std::optional<std::string> load_answer(const AnswerKey &key, int part);
+
+// Store (or replace) one part's answer. Written aside and renamed into place,
+// so processes sharing the directory only ever see whole entries; failures
+// are reported on stderr and otherwise ignored.
+void store_answer(const AnswerKey &key, int part, std::string_view answer);
+
+}  // namespace aoc
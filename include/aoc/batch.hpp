@@ -0,0 +1,53 @@
+#pragma once
+
+#include "aoc/day.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace aoc {
+
+// The inputs named by `source`: every regular file of a directory, sorted by
+// name, or the lines of a manifest file. Manifest paths are relative to the
+// manifest's directory; blank lines and lines starting with '#' are skipped.
+std::vector<std::filesystem::path> batch_inputs(const std::filesystem::path &source, bool manifest);
+
+// One input of a batch, solved or failed.
+struct BatchFile {
+    std::filesystem::path path;
+    std::size_t input_bytes{0};
+    std::uint64_t input_hash{0};  // only computed when `hash` is set
+    std::optional<DayResult> result;
+    std::string error;
+    long long wall_micros{0};  // map + parse + parts
+};
+
+struct BatchStats {
+    std::size_t files{0};
+    std::size_t failed{0};
+    std::uint64_t bytes{0};
+    long long wall_micros{0};
+    std::size_t threads{0};
+    std::size_t in_flight{0};
+};
+
+// Solve every input with `entry`, one pool task per file. At most
+// `in_flight` files are mapped or waiting to be reported at any time, which
+// caps memory however long the list is. `done` runs on the calling thread,
+// in input order, as soon as a file and every file before it finished.
+BatchStats run_batch(const DayEntry &entry, std::span<const std::filesystem::path> inputs, std::size_t in_flight,
+                     bool hash, const std::function<void(const BatchFile &)> &done);
+
+// "Batch: N files (F failed), X MB in Y ms on T threads: A files/s, B MB/s"
+void print_batch_stats(const BatchStats &stats);
+
+// run_day's batch mode: a directory, or "@manifest", instead of one input.
+int run_day_batch(const DayEntry &entry, const std::filesystem::path &source, bool manifest);
+
+}  // namespace aoc
@@ -0,0 +1,268 @@
+#pragma once
+
+#include "aoc.hpp"
+#include "aoc/answer_cache.hpp"
+#include "aoc/model_cache.hpp"
+#include "aoc/stream.hpp"
+
+#include <bit>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aoc {
+
+// A puzzle day: parse the input once into a Model, then solve each part
+// from the shared model. part2 is optional (day 12 only has one part).
+//
+//   struct Day05 {
+//       struct Model { ... };
+//       static Model parse(Lines lines);
+//       static long long part1(const Model &model);
+//       static long long part2(const Model &model);
+//   };
+template <typename D>
+concept Day = requires(Lines lines, const typename D::Model &model) {
+    { D::parse(lines) } -> std::convertible_to<typename D::Model>;
+    D::part1(model);
+};
+
+template <typename D>
+concept HasPart2 = Day<D> && requires(const typename D::Model &model) {
+    D::part2(model);
+};
+
+// Keys the answer cache together with the binary (see binary_id); a day whose
+// answers change without its code changing (data tables read at run time,
+// say) can define `static constexpr std::uint32_t solver_version` and bump it.
+template <Day D>
+constexpr std::uint32_t solver_version() {
+    if constexpr (requires { D::solver_version; }) {
+        return D::solver_version;
+    } else {
+        return 1;
+    }
+}
+
+// One solved part: the answer rendered as text plus its timing.
+struct PartResult {
+    int part{0};
+    std::string answer;
+    Timing timing;
+};
+
+// Bit per part (1 << (part - 1)) selecting what solve_day runs; parsing
+// always happens.
+inline constexpr unsigned all_parts = 0b11;
+
+struct DayResult {
+    Timing parse;
+    bool model_cached{false};    // the model came from the .aocbin cache
+    bool answers_cached{false};  // every part came from the answer cache; nothing was parsed
+    std::vector<PartResult> parts;
+};
+
+// A day that can also solve an unbounded input in constant memory: its
+// Stream takes the input one line at a time and can give the answers so far
+// at any point. part2 is optional, as for the day itself.
+//
+//   struct Stream {
+//       void feed(std::string_view line);
+//       long long part1();
+//       long long part2();
+//   };
+template <typename D>
+concept HasStream = Day<D> && requires(typename D::Stream &stream, std::string_view line) {
+    stream.feed(line);
+    stream.part1();
+};
+
+// A registered day. `solve` parses the input and runs the selected parts;
+// `stream`, set for days with HasStream, feeds it a LineReader instead.
+struct DayEntry {
+    int day{0};
+    std::string_view default_path;
+    DayResult (*solve)(Lines lines, unsigned parts){nullptr};
+    DayResult (*stream)(LineReader &input, std::size_t every){nullptr};
+};
+
+// D::parse, or the model cache for days that support it (see HasModelCache).
+// A miss parses as usual and stores the model for the next run.
+template <Day D, int Number>
+typename D::Model parse_model(Lines lines, bool &from_cache) {
+    if constexpr (HasModelCache<D>) {
+        if (Number != 0 && model_cache_enabled()) {
+            const std::uint64_t hash = hash_lines(lines);
+            if (const auto cached = open_cached_model(Number, D::model_version, hash)) {
+                try {
+                    BinaryReader in(cached->payload());
+                    auto model = typename D::Model(D::load(in));
+                    if (in.done()) {
+                        from_cache = true;
+                        return model;
+                    }
+                } catch (const std::runtime_error &) {
+                    // unreadable payload: parse and overwrite it
+                }
+            }
+            auto model = typename D::Model(D::parse(lines));
+            BinaryWriter out;
+            D::save(model, out);
+            store_cached_model(Number, D::model_version, hash, out.bytes());
+            return model;
+        }
+    }
+    return typename D::Model(D::parse(lines));
+}
+
+// Time parse, part 1 and part 2 separately while reusing one parsed model.
+// Number is the day, which keys the model and answer caches; 0 leaves both
+// alone.
+//
+// With the answer cache on, a run whose selected parts are all cached
+// returns them without parsing; otherwise it solves and stores. Under
+// --verify-cache it always solves and throws when a stored answer differs,
+// after replacing it with the fresh one.
+template <Day D, int Number = 0>
+DayResult solve_day(Lines lines, unsigned parts = all_parts) {
+    const auto render = [](const auto &answer) {
+        std::ostringstream os;
+        os << answer;
+        return os.str();
+    };
+    constexpr unsigned available = HasPart2<D> ? 0b11 : 0b01;
+    parts &= available;
+
+    std::optional<AnswerKey> key;
+    if (Number != 0 && answer_cache_enabled()) {
+        key = AnswerKey{Number, solver_version<D>(), *binary_id(), hash_lines(lines)};
+        if (!options().verify_cache) {
+            DayResult cached;
+            cached.answers_cached = true;
+            for (int part = 1; part <= 2; ++part) {
+                if (parts & (1U << (part - 1))) {
+                    auto [answer, t] = time_it([&] { return load_answer(*key, part); });
+                    if (!answer) {
+                        break;
+                    }
+                    cached.parts.push_back({part, std::move(*answer), t});
+                }
+            }
+            if (cached.parts.size() == static_cast<std::size_t>(std::popcount(parts))) {
+                return cached;
+            }
+        }
+    }
+
+    DayResult result;
+    auto [model, tp] = time_it([&] { return parse_model<D, Number>(lines, result.model_cached); });
+    result.parse = tp;
+
+    if (parts & 0b01) {
+        auto [ans1, t1] = time_it([&] { return D::part1(model); });
+        result.parts.push_back({1, render(ans1), t1});
+    }
+
+    if constexpr (HasPart2<D>) {
+        if (parts & 0b10) {
+            auto [ans2, t2] = time_it([&] { return D::part2(model); });
+            result.parts.push_back({2, render(ans2), t2});
+        }
+    }
+
+    if (key) {
+        for (const auto &p : result.parts) {
+            const auto stored = options().verify_cache ? load_answer(*key, p.part) : std::nullopt;
+            if (!stored || *stored != p.answer) {
+                store_answer(*key, p.part, p.answer);
+            }
+            if (stored && *stored != p.answer) {
+                throw std::runtime_error("answer cache: day " + std::to_string(Number) + " part " +
+                                         std::to_string(p.part) + " cached " + *stored + ", solved " +
+                                         p.answer);
+            }
+        }
+    }
+    return result;
+}
+
+// "Lines N: part 1 = X, part 2 = Y", flushed so a reader at the other end of
+// a pipe sees it at once.
+void print_running(std::size_t lines, const std::vector<PartResult> &parts);
+
+// Feed every line of `input` to a D::Stream and take its answers at the end,
+// printing them every `every` lines along the way (0 = only at the end).
+// result.parse times the whole read; the parts only time the final answers.
+template <HasStream D>
+DayResult stream_day(LineReader &input, std::size_t every) {
+    const auto answers = [](typename D::Stream &stream) {
+        std::vector<PartResult> parts;
+        auto [ans1, t1] = time_it([&] { return stream.part1(); });
+        parts.push_back({1, std::to_string(ans1), t1});
+        if constexpr (requires { stream.part2(); }) {
+            auto [ans2, t2] = time_it([&] { return stream.part2(); });
+            parts.push_back({2, std::to_string(ans2), t2});
+        }
+        return parts;
+    };
+
+    typename D::Stream stream;
+    DayResult result;
+    const auto start = std::chrono::steady_clock::now();
+    std::string_view line;
+    while (input.next(line)) {
+        stream.feed(line);
+        if (every != 0 && input.lines() % every == 0) {
+            print_running(input.lines(), answers(stream));
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+    result.parse.micros = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    result.parts = answers(stream);
+    return result;
+}
+
+template <typename D>
+constexpr DayResult (*stream_entry())(LineReader &, std::size_t) {
+    if constexpr (HasStream<D>) {
+        return &stream_day<D>;
+    } else {
+        return nullptr;
+    }
+}
+
+// Days add themselves here through AOC_REGISTER_DAY during static
+// initialization. Throws when the same day is registered twice.
+void register_day(const DayEntry &entry);
+
+// Every registered day, ordered by day number.
+std::span<const DayEntry> registered_days();
+
+// nullptr when the day is not linked into this binary.
+const DayEntry *find_day(int day);
+
+// Print a solved day the way the per-day binaries always have:
+// the parse time, then one "Part N:" line per part.
+void print_day(const DayResult &result);
+
+// Shared main body: map argv[1] (or the day's default path), solve, print.
+// A directory or "@manifest" as argv[1] solves a whole batch of inputs; "-",
+// a FIFO or --stream reads the input as a stream (see HasStream).
+int run_day(const DayEntry &entry, int argc, char **argv);
+
+}  // namespace aoc
+
+#define AOC_REGISTER_DAY(number, D, path)                                                                    \
+    namespace {                                                                                              \
+    [[maybe_unused]] const bool aoc_day_registered =                                                         \
+        (::aoc::register_day({(number), (path), &::aoc::solve_day<D, (number)>,                              \
+                              ::aoc::stream_entry<D>()}),                                                    \
+         true);                                                                                              \
+    }
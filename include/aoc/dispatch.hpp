@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+
+// Runtime CPU dispatch. A kernel is compiled once per instruction-set level
+// and the best version the CPU supports is picked on first use, so one
+// portable binary still runs AVX2/AVX-512 code on hosts that have it.
+// --isa=NAME / AOC_ISA=NAME caps the level, e.g. to benchmark the SSE path
+// on an AVX-512 machine.
+
+#if defined(__x86_64__) || defined(__i386__)
+#define AOC_DISPATCH_X86 1
+#define AOC_TARGET_SSE42 __attribute__((target("sse4.2,popcnt")))
+#define AOC_TARGET_AVX2 __attribute__((target("avx2,bmi,bmi2,popcnt,fma")))
+#define AOC_TARGET_AVX512 __attribute__((target("avx512f,avx512bw,avx512vl,avx512dq,avx2,bmi,bmi2,popcnt,fma")))
+#endif
+
+namespace aoc {
+
+// Instruction-set levels in increasing order; each implies the ones before.
+enum class Isa : std::uint8_t {
+    scalar,
+    sse2,
+    sse42,
+    avx2,
+    avx512,
+};
+
+// What code compiled without target attributes may use: SSE2 is part of the
+// x86-64 baseline.
+#if defined(__SSE2__)
+inline constexpr Isa baseline_isa = Isa::sse2;
+#else
+inline constexpr Isa baseline_isa = Isa::scalar;
+#endif
+
+// "scalar", "sse2", "sse4.2", "avx2", "avx512".
+const char *isa_name(Isa isa) noexcept;
+
+// Inverse of isa_name; nothing for an unknown name.
+std::optional<Isa> parse_isa(std::string_view name) noexcept;
+
+// Highest level this CPU and OS support, from cpuid; scalar off x86.
+Isa host_isa() noexcept;
+
+// The level kernels are selected for: host_isa(), lowered by --isa. Read
+// once, on the first call.
+Isa active_isa() noexcept;
+
+template <typename Fn>
+struct KernelVersion {
+    Isa isa;
+    Fn fn;
+};
+
+// The highest version at or below `limit`, or the lowest one when none is
+// (AOC_ISA=scalar still runs a kernel that only has baseline clones).
+template <typename Fn>
+KernelVersion<Fn> select_kernel(std::span<const KernelVersion<Fn>> versions, Isa limit) {
+    if (versions.empty()) {
+        throw std::runtime_error("select_kernel: no versions");
+    }
+    const KernelVersion<Fn> *best = nullptr;
+    const KernelVersion<Fn> *lowest = &versions.front();
+    for (const auto &v : versions) {
+        if (v.isa <= limit && (best == nullptr || v.isa > best->isa)) {
+            best = &v;
+        }
+        if (v.isa < lowest->isa) {
+            lowest = &v;
+        }
+    }
+    return best != nullptr ? *best : *lowest;
+}
+
+template <typename Fn, std::size_t N>
+KernelVersion<Fn> select_kernel(const KernelVersion<Fn> (&versions)[N], Isa limit) {
+    return select_kernel(std::span<const KernelVersion<Fn>>(versions), limit);
+}
+
+// The version for active_isa(). Call sites keep the result in a static.
+template <typename Fn, std::size_t N>
+KernelVersion<Fn> select_kernel(const KernelVersion<Fn> (&versions)[N]) {
+    return select_kernel(versions, active_isa());
+}
+
+}  // namespace aoc
+
+// Compile one body for every level. Given an always-inline function `name##_body`
+// with the signature `ret (params)`, defines `name##_baseline` and, on x86,
+// `name##_sse42`, `name##_avx2` and `name##_avx512` that call it with
+// `args`, plus the array `name##_versions` for select_kernel. The body is
+// force-inlined into each clone, so the compiler vectorizes it for that ISA.
+//
+//   [[gnu::always_inline]] inline long sum_row_body(const int *p, std::size_t n) { ... }
+//   AOC_KERNEL_VERSIONS(sum_row, long, (const int *p, std::size_t n), (p, n))
+//   static const auto sum_row = aoc::select_kernel(sum_row_versions).fn;
+#if defined(AOC_DISPATCH_X86)
+#define AOC_KERNEL_VERSIONS(name, ret, params, args)                                                      \
+    ret name##_baseline params { return name##_body args; }                                               \
+    AOC_TARGET_SSE42 ret name##_sse42 params { return name##_body args; }                                 \
+    AOC_TARGET_AVX2 ret name##_avx2 params { return name##_body args; }                                   \
+    AOC_TARGET_AVX512 ret name##_avx512 params { return name##_body args; }                               \
+    constexpr ::aoc::KernelVersion<ret(*) params> name##_versions[] = {                                   \
+        {::aoc::baseline_isa, name##_baseline},                                                           \
+        {::aoc::Isa::sse42, name##_sse42},                                                                \
+        {::aoc::Isa::avx2, name##_avx2},                                                                  \
+        {::aoc::Isa::avx512, name##_avx512},                                                              \
+    };
+#else
+#define AOC_KERNEL_VERSIONS(name, ret, params, args)                                                      \
+    ret name##_baseline params { return name##_body args; }                                               \
+    constexpr ::aoc::KernelVersion<ret(*) params> name##_versions[] = {                                   \
+        {::aoc::baseline_isa, name##_baseline},                                                           \
+    };
+#endif
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "aoc.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace aoc {
+
+// Non-owning row-major view: row y starts at data + y * stride.
+template <typename T>
+struct GridView {
+    T *data{nullptr};
+    std::size_t width{0};
+    std::size_t height{0};
+    std::size_t stride{0};
+
+    [[nodiscard]] T &operator()(std::size_t x, std::size_t y) const noexcept { return data[y * stride + x]; }
+    [[nodiscard]] std::span<T> row(std::size_t y) const noexcept { return {data + y * stride, width}; }
+};
+
+// The input lines as a character grid, without copying: the lines of a
+// mapped file (or of one string) sit at a fixed stride in one buffer.
+// Throws when they differ in width or are not evenly spaced.
+GridView<const char> text_grid(Lines lines);
+
+// Contiguous row-major grid with a `pad`-cell border of sentinel values on
+// every side. (x, y) addresses the interior, [0, width) x [0, height); any
+// coordinate up to `pad` outside it reads the sentinel, so neighbour loops
+// need no bounds checks.
+template <typename T>
+class Grid {
+public:
+    Grid() = default;
+
+    Grid(std::size_t width, std::size_t height, T fill, T border, std::size_t pad = 1)
+        : width_(width), height_(height), pad_(pad), stride_(width + 2 * pad),
+          cells_(stride_ * (height + 2 * pad), border) {
+        for (std::size_t y = 0; y < height; ++y) {
+            std::fill_n(row(static_cast<std::ptrdiff_t>(y)), width, fill);
+        }
+    }
+
+    // Copy `text` in, mapping each character through `cell`.
+    template <typename F>
+    Grid(GridView<const char> text, F &&cell, T border, std::size_t pad = 1)
+        : Grid(text.width, text.height, border, border, pad) {
+        for (std::size_t y = 0; y < height_; ++y) {
+            const auto src = text.row(y);
+            T *dst = row(static_cast<std::ptrdiff_t>(y));
+            for (std::size_t x = 0; x < width_; ++x) {
+                dst[x] = cell(src[x]);
+            }
+        }
+    }
+
+    [[nodiscard]] std::size_t width() const noexcept { return width_; }
+    [[nodiscard]] std::size_t height() const noexcept { return height_; }
+    [[nodiscard]] std::size_t stride() const noexcept { return stride_; }
+    [[nodiscard]] std::size_t pad() const noexcept { return pad_; }
+
+    // Interior or border cell; -pad <= x < width + pad, likewise y.
+    [[nodiscard]] T &operator()(std::ptrdiff_t x, std::ptrdiff_t y) noexcept { return cells_[index(x, y)]; }
+    [[nodiscard]] const T &operator()(std::ptrdiff_t x, std::ptrdiff_t y) const noexcept {
+        return cells_[index(x, y)];
+    }
+
+    // First interior cell of row y; the border is reachable at negative
+    // offsets and past width().
+    [[nodiscard]] T *row(std::ptrdiff_t y) noexcept { return &cells_[index(0, y)]; }
+    [[nodiscard]] const T *row(std::ptrdiff_t y) const noexcept { return &cells_[index(0, y)]; }
+
+    [[nodiscard]] bool contains(std::ptrdiff_t x, std::ptrdiff_t y) const noexcept {
+        return x >= 0 && y >= 0 && static_cast<std::size_t>(x) < width_ && static_cast<std::size_t>(y) < height_;
+    }
+
+private:
+    [[nodiscard]] std::size_t index(std::ptrdiff_t x, std::ptrdiff_t y) const noexcept {
+        return static_cast<std::size_t>(y + static_cast<std::ptrdiff_t>(pad_)) * stride_ +
+               static_cast<std::size_t>(x + static_cast<std::ptrdiff_t>(pad_));
+    }
+
+    std::size_t width_{0};
+    std::size_t height_{0};
+    std::size_t pad_{0};
+    std::size_t stride_{0};
+    std::vector<T> cells_;
+};
+
+// One bit per cell, 64 cells per word, bit x % 64 of word x / 64 in each
+// row. Every row has a zero word before and after it and there is a zero
+// row above and below the grid, so whole-word neighbour arithmetic
+// (row(y)[k - 1], row(y - 1)[k], ...) needs no edge cases. Bits past width()
+// in a row's last word must stay zero.
+class BitGrid {
+public:
+    using Word = std::uint64_t;
+    static constexpr std::size_t word_bits = 64;
+
+    BitGrid() = default;
+    BitGrid(std::size_t width, std::size_t height);
+
+    // Set the cells of `text` for which `on(c)` is true.
+    template <typename F>
+    BitGrid(GridView<const char> text, F &&on) : BitGrid(text.width, text.height) {
+        for (std::size_t y = 0; y < height_; ++y) {
+            const auto src = text.row(y);
+            Word *dst = row(static_cast<std::ptrdiff_t>(y));
+            for (std::size_t k = 0; k < words_; ++k) {
+                const std::size_t end = std::min(width_, (k + 1) * word_bits);
+                Word word = 0;
+                for (std::size_t x = k * word_bits; x < end; ++x) {
+                    word |= static_cast<Word>(on(src[x]) ? 1U : 0U) << (x % word_bits);
+                }
+                dst[k] = word;
+            }
+        }
+    }
+
+    [[nodiscard]] std::size_t width() const noexcept { return width_; }
+    [[nodiscard]] std::size_t height() const noexcept { return height_; }
+    [[nodiscard]] std::size_t words_per_row() const noexcept { return words_; }
+
+    // The interior words of row y, -1 <= y <= height(); [-1] and
+    // [words_per_row()] are the zero pad words.
+    [[nodiscard]] Word *row(std::ptrdiff_t y) noexcept { return &words_data_[offset(y)]; }
+    [[nodiscard]] const Word *row(std::ptrdiff_t y) const noexcept { return &words_data_[offset(y)]; }
+
+    // False outside the grid; y may be one row past either edge.
+    [[nodiscard]] bool get(std::ptrdiff_t x, std::ptrdiff_t y) const noexcept {
+        if (x < 0 || static_cast<std::size_t>(x) >= width_) {
+            return false;
+        }
+        const auto ux = static_cast<std::size_t>(x);
+        return ((row(y)[ux / word_bits] >> (ux % word_bits)) & 1U) != 0;
+    }
+
+    void set(std::size_t x, std::size_t y, bool value) noexcept;
+
+    // Number of set cells.
+    [[nodiscard]] std::size_t count() const noexcept;
+
+private:
+    [[nodiscard]] std::size_t offset(std::ptrdiff_t y) const noexcept {
+        return static_cast<std::size_t>(y + 1) * stride_ + 1;
+    }
+
+    std::size_t width_{0};
+    std::size_t height_{0};
+    std::size_t words_{0};
+    std::size_t stride_{0};  // words_ + 1: the leading pad word is shared with the previous row's trailing one
+    std::vector<Word> words_data_;
+};
+
+}  // namespace aoc
@@ -0,0 +1,63 @@
+#pragma once
+
+// Leveled diagnostics. AOC_LOG(level, args...) streams args to stderr as one
+// line when `level` is within both the compile-time ceiling AOC_LOG_LEVEL
+// (the CMake option of the same name, default info) and the runtime
+// verbosity from --log / AOC_LOG (default warn). Levels above the ceiling
+// compile to nothing, so debug prints can stay next to hot loops; their
+// arguments are still type-checked.
+//
+//   AOC_LOG(debug, "bank ", b, " joltage ", joltage);
+
+#include <cstdint>
+#include <optional>
+#include <sstream>
+#include <string_view>
+
+#if !defined(AOC_LOG_LEVEL)
+#define AOC_LOG_LEVEL 2
+#endif
+
+namespace aoc {
+
+enum class LogLevel : std::uint8_t {
+    error,
+    warn,
+    info,
+    debug,
+    trace,
+};
+
+// The most verbose level this build can print.
+inline constexpr LogLevel compiled_log_level = static_cast<LogLevel>(AOC_LOG_LEVEL);
+
+// "error", "warn", "info", "debug", "trace".
+const char *log_level_name(LogLevel level) noexcept;
+
+// Inverse of log_level_name; nothing for an unknown name.
+std::optional<LogLevel> parse_log_level(std::string_view name) noexcept;
+
+// True when the runtime verbosity includes `level`.
+bool log_enabled(LogLevel level) noexcept;
+
+// Write "level: text" and a newline to stderr in one piece; concurrent
+// callers never interleave within a line.
+void log_line(LogLevel level, std::string_view text);
+
+template <typename... Args>
+void log_message(LogLevel level, const Args &...args) {
+    std::ostringstream os;
+    (os << ... << args);
+    log_line(level, os.view());
+}
+
+}  // namespace aoc
+
+#define AOC_LOG(level, ...)                                                         \
+    do {                                                                            \
+        if constexpr (::aoc::LogLevel::level <= ::aoc::compiled_log_level) {       \
+            if (::aoc::log_enabled(::aoc::LogLevel::level)) {                       \
+                ::aoc::log_message(::aoc::LogLevel::level, __VA_ARGS__);            \
+            }                                                                       \
+        }                                                                           \
+    } while (false)
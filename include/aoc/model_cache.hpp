@@ -0,0 +1,137 @@
+#pragma once
+
+#include "aoc.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace aoc {
+
+// Append-only binary encoder for parsed models. Values are stored in host
+// byte order; a cache file is only ever read back on the machine that wrote
+// it.
+class BinaryWriter {
+public:
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    void put(const T &value) {
+        bytes_.append(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    void put(const std::vector<T> &values) {
+        put(static_cast<std::uint64_t>(values.size()));
+        bytes_.append(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+    }
+
+    void put(std::string_view text) {
+        put(static_cast<std::uint64_t>(text.size()));
+        bytes_.append(text);
+    }
+
+    [[nodiscard]] std::string_view bytes() const noexcept { return bytes_; }
+
+private:
+    std::string bytes_;
+};
+
+// Reads back what BinaryWriter wrote, in the same order. Running past the
+// end throws std::runtime_error, which the cache treats as a miss.
+class BinaryReader {
+public:
+    explicit BinaryReader(std::string_view bytes) noexcept : bytes_(bytes) {}
+
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    T get() {
+        T value;
+        std::memcpy(&value, take(sizeof(T)).data(), sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    std::vector<T> get_vector() {
+        const auto count = get<std::uint64_t>();
+        if (count > bytes_.size() / std::max<std::size_t>(sizeof(T), 1)) {
+            throw std::runtime_error("model cache: truncated vector");
+        }
+        std::vector<T> values(static_cast<std::size_t>(count));
+        const auto raw = take(values.size() * sizeof(T));
+        std::memcpy(values.data(), raw.data(), raw.size());
+        return values;
+    }
+
+    std::string get_string() {
+        const auto size = get<std::uint64_t>();
+        return std::string(take(static_cast<std::size_t>(size)));
+    }
+
+    [[nodiscard]] bool done() const noexcept { return bytes_.empty(); }
+
+private:
+    std::string_view take(std::size_t n) {
+        if (n > bytes_.size()) {
+            throw std::runtime_error("model cache: truncated payload");
+        }
+        const auto head = bytes_.substr(0, n);
+        bytes_.remove_prefix(n);
+        return head;
+    }
+
+    std::string_view bytes_;
+};
+
+// A day opts into the model cache by describing how its Model is stored.
+// Bump model_version whenever parse() or the Model layout changes; older
+// cache files are then ignored.
+//
+//   static constexpr std::uint32_t model_version = 1;
+//   static void save(const Model &model, BinaryWriter &out);
+//   static Model load(BinaryReader &in);
+template <typename D>
+concept HasModelCache = requires(const typename D::Model &model, BinaryWriter &out, BinaryReader &in) {
+    { D::model_version } -> std::convertible_to<std::uint32_t>;
+    D::save(model, out);
+    { D::load(in) } -> std::convertible_to<typename D::Model>;
+};
+
+// A valid .aocbin file, memory-mapped.
+class CachedModel {
+public:
+    virtual ~CachedModel() = default;
+    [[nodiscard]] virtual std::string_view payload() const noexcept = 0;
+};
+
+// True when --model-cache / AOC_MODEL_CACHE is on and --no-cache is not.
+bool model_cache_enabled() noexcept;
+
+// FNV-1a over the lines joined by '\n', i.e. hash_input() of the file for
+// inputs with a trailing newline and no '\r'.
+std::uint64_t hash_lines(Lines lines) noexcept;
+
+// The cached model for this day, model version and input, or nullptr when
+// there is none or the file does not validate (wrong magic, format, day,
+// version, hash or size).
+std::unique_ptr<CachedModel> open_cached_model(int day, std::uint32_t version, std::uint64_t input_hash);
+
+// Write the payload under its key. The file is written aside and renamed
+// into place, so concurrent runs never see a partial file. Failures are
+// reported on stderr and otherwise ignored: the cache is an optimization.
+void store_cached_model(int day, std::uint32_t version, std::uint64_t input_hash, std::string_view payload);
+
+// Write head + body to a temporary file next to `path`, then rename it over
+// `path`. Shared by the model and answer caches; failures only warn.
+void write_file_atomically(const std::filesystem::path &path, std::string_view head, std::string_view body);
+
+}  // namespace aoc
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace aoc {
+
+// Work-stealing pool. Every worker owns a deque: it pushes and pops its own
+// tasks at the back and steals from the front of the others when idle.
+// Tasks submitted from outside the pool land in a shared inject queue.
+// A pool of size N runs N - 1 workers; the thread that waits on a TaskGroup
+// runs tasks as well, so a pool of size 1 executes everything inline.
+class ThreadPool {
+public:
+    using Task = std::move_only_function<void()>;
+
+    explicit ThreadPool(std::size_t threads, bool pin = false);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    // Total parallelism, counting the waiting thread.
+    [[nodiscard]] std::size_t size() const noexcept { return workers_.size() + 1; }
+
+    void submit(Task task);
+
+    // Run one queued task on the calling thread. False when nothing was found.
+    bool run_one();
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void worker_loop(std::size_t index, bool pin);
+    std::optional<Task> pop_local(std::size_t index);
+    std::optional<Task> steal(std::size_t thief);
+    bool run_one(std::size_t index);
+
+    std::vector<std::unique_ptr<Queue>> queues_;  // one per worker, then the inject queue
+    std::vector<std::jthread> workers_;
+
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    std::atomic<std::size_t> queued_{0};
+    bool stop_{false};
+};
+
+// The process-wide pool, built on first use from options().threads
+// (0 = one per hardware thread) and options().pin.
+ThreadPool &thread_pool();
+
+// Tasks spawned into a group can be waited on together. wait() helps run
+// queued tasks instead of blocking and rethrows the first task exception.
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool &pool = thread_pool()) : pool_(pool) {}
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup &operator=(const TaskGroup &) = delete;
+
+    template <typename F>
+    void spawn(F &&f) {
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        pool_.submit([this, fn = std::forward<F>(f)]() mutable {
+            try {
+                fn();
+            } catch (...) {
+                std::lock_guard lock(error_mutex_);
+                if (!error_) {
+                    error_ = std::current_exception();
+                }
+            }
+            pending_.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    void wait();
+
+private:
+    ThreadPool &pool_;
+    std::atomic<std::size_t> pending_{0};
+    std::mutex error_mutex_;
+    std::exception_ptr error_;
+};
+
+namespace detail {
+
+// Aim for a few chunks per thread so stealing can even out uneven work.
+inline std::size_t chunk_size(std::size_t n, std::size_t grain, std::size_t threads) {
+    if (grain != 0) {
+        return grain;
+    }
+    return std::max<std::size_t>(1, n / (threads * 4));
+}
+
+}  // namespace detail
+
+// Call f(i) for every i in [begin, end). `grain` is the number of indices per
+// task; 0 picks one from the pool size. Runs inline on a single-thread pool.
+template <typename F>
+void parallel_for(std::size_t begin, std::size_t end, F &&f, std::size_t grain = 0) {
+    if (end <= begin) {
+        return;
+    }
+    auto &pool = thread_pool();
+    const std::size_t n = end - begin;
+    const std::size_t chunk = detail::chunk_size(n, grain, pool.size());
+    if (pool.size() == 1 || chunk >= n) {
+        for (std::size_t i = begin; i < end; ++i) {
+            f(i);
+        }
+        return;
+    }
+
+    TaskGroup group(pool);
+    for (std::size_t lo = begin; lo < end; lo += chunk) {
+        const std::size_t hi = std::min(end, lo + chunk);
+        group.spawn([&f, lo, hi] {
+            for (std::size_t i = lo; i < hi; ++i) {
+                f(i);
+            }
+        });
+    }
+    group.wait();
+}
+
+// Fold map(i) over [begin, end) with `reduce`, starting from `init`.
+// Chunk results are combined in index order, so the result matches the
+// serial loop as long as `reduce` is associative.
+template <typename T, typename Map, typename Reduce>
+T parallel_reduce(std::size_t begin, std::size_t end, T init, Map &&map, Reduce &&reduce,
+                  std::size_t grain = 0) {
+    if (end <= begin) {
+        return init;
+    }
+    auto &pool = thread_pool();
+    const std::size_t n = end - begin;
+    const std::size_t chunk = detail::chunk_size(n, grain, pool.size());
+    const std::size_t chunks = (n + chunk - 1) / chunk;
+
+    std::vector<std::optional<T>> partials(chunks);
+    parallel_for(0, chunks, [&](std::size_t c) {
+        const std::size_t lo = begin + c * chunk;
+        const std::size_t hi = std::min(end, lo + chunk);
+        T acc = map(lo);
+        for (std::size_t i = lo + 1; i < hi; ++i) {
+            acc = reduce(std::move(acc), map(i));
+        }
+        partials[c] = std::move(acc);
+    }, 1);
+
+    for (auto &partial : partials) {
+        init = reduce(std::move(init), std::move(*partial));
+    }
+    return init;
+}
+
+// Sum map(i) over [begin, end); the common case of parallel_reduce.
+template <typename T, typename Map>
+T parallel_sum(std::size_t begin, std::size_t end, Map &&map, std::size_t grain = 0) {
+    return parallel_reduce(begin, end, T{}, std::forward<Map>(map), std::plus<T>{}, grain);
+}
+
+}  // namespace aoc
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace aoc {
+
+// Hardware counters collected around one timed region.
+enum class PerfEvent : std::size_t {
+    cycles,
+    instructions,
+    l1d_misses,
+    llc_misses,
+    branch_misses,
+    count_,
+};
+
+struct PerfCounters {
+    // Missing values mean the kernel or CPU refused that particular counter.
+    std::array<std::optional<std::uint64_t>, static_cast<std::size_t>(PerfEvent::count_)> values{};
+
+    [[nodiscard]] std::optional<std::uint64_t> operator[](PerfEvent e) const noexcept {
+        return values[static_cast<std::size_t>(e)];
+    }
+
+    // Scale every counter down by `runs` (benchmark mode reports per run).
+    void divide(std::size_t runs) noexcept;
+};
+
+// Per-thread set of perf_event_open counters, opened lazily on first use.
+// When counters are not allowed (perf_event_paranoid, containers, non-Linux)
+// start()/stop() are no-ops and stop() returns nullopt; the reason is printed
+// once to stderr. Work handed to thread-pool workers is not counted;
+// thread_pool() warns when --perf meets a pool of more than one thread.
+class PerfSession {
+public:
+    static PerfSession &thread_local_instance();
+
+    PerfSession(const PerfSession &) = delete;
+    PerfSession &operator=(const PerfSession &) = delete;
+    ~PerfSession();
+
+    [[nodiscard]] bool available() const noexcept { return available_; }
+
+    void start() noexcept;
+    std::optional<PerfCounters> stop() noexcept;
+
+private:
+    PerfSession();
+
+    std::array<int, static_cast<std::size_t>(PerfEvent::count_)> fds_{};
+    bool available_{false};
+};
+
+// "  perf: ..." line with IPC and misses per input byte (when known).
+void print_perf(const PerfCounters &counters, std::size_t input_bytes);
+
+}  // namespace aoc
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "aoc/day.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace aoc {
+
+// Everything known about one solved day, ready to be written out.
+struct DayReport {
+    int day{0};
+    std::size_t input_bytes{0};
+    std::uint64_t input_hash{0};
+    std::string input;  // input path as given
+    DayResult result;
+};
+
+// 64-bit FNV-1a of the input bytes, so result files from different inputs
+// are never compared against each other by accident.
+std::uint64_t hash_input(std::string_view bytes) noexcept;
+
+// Column names shared by the JSON and CSV writers, in output order. Every
+// record is one stage of one day: "parse", "part1" or "part2".
+std::span<const std::string_view> report_columns();
+
+// JSON: an array of flat objects keyed by report_columns(); values that were
+// not measured are null. CSV: a header row, then one row per stage with
+// empty cells for missing values.
+void write_report(std::ostream &os, OutputFormat format, std::span<const DayReport> reports);
+
+// While alive, std::cout writes to stderr so that debug prints from the
+// solvers cannot end up inside machine-readable output.
+class StdoutToStderr {
+public:
+    StdoutToStderr();
+    ~StdoutToStderr();
+
+    StdoutToStderr(const StdoutToStderr &) = delete;
+    StdoutToStderr &operator=(const StdoutToStderr &) = delete;
+
+    // The original stdout stream buffer.
+    std::ostream &stdout_stream() noexcept { return out_; }
+
+private:
+    std::streambuf *saved_;
+    std::ostream out_;
+};
+
+}  // namespace aoc
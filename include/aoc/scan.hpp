@@ -0,0 +1,65 @@
+#pragma once
+
+#include "aoc/dispatch.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace aoc {
+
+// Delimiter classes understood by scan_delimiters; combine with '|'.
+enum Delim : unsigned {
+    newline = 1u << 0,
+    comma   = 1u << 1,
+    space   = 1u << 2,
+    dash    = 1u << 3,
+    colon   = 1u << 4,
+};
+
+using DelimSet = unsigned;
+
+// Offset tables produced by a single pass over a buffer.
+// `fields` has the offset of every delimiter in the requested set, `lines`
+// the offset of every '\n' (always recorded). Offsets are relative to the
+// start of the scanned text, so one table covers buffers up to 4 GiB.
+struct DelimiterOffsets {
+    std::vector<std::uint32_t> fields;
+    std::vector<std::uint32_t> lines;
+
+    void clear() noexcept {
+        fields.clear();
+        lines.clear();
+    }
+};
+
+// Vectorized delimiter scan: the best of AVX-512BW, AVX2 and SSE2 the CPU
+// has (see active_isa), plain scalar code off x86. The choice is made once at
+// runtime. `out` is cleared first but keeps its capacity, so reusing it
+// across calls does not allocate.
+void scan_delimiters(std::string_view text, DelimSet set, DelimiterOffsets &out);
+
+// Name of the code path scan_delimiters picked ("avx512", "avx2", "sse2" or "scalar").
+const char *scan_isa() noexcept;
+
+using ScanKernel = void (*)(std::string_view text, DelimSet set, DelimiterOffsets &out);
+
+// Every compiled version of the scan, for benchmarking one against another.
+// They append to `out` without clearing it or checking the 4 GiB limit.
+std::span<const KernelVersion<ScanKernel>> scan_versions() noexcept;
+
+// Call f(piece) for every piece of `text` between the delimiters at `cuts`,
+// including the piece after the last cut.
+template <typename F>
+void for_each_field(std::string_view text, std::span<const std::uint32_t> cuts, F &&f) {
+    std::size_t start = 0;
+    for (const auto cut : cuts) {
+        f(text.substr(start, cut - start));
+        start = static_cast<std::size_t>(cut) + 1;
+    }
+    f(text.substr(std::min(start, text.size())));
+}
+
+}  // namespace aoc
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+namespace aoc {
+
+// Lines of stdin, a pipe or a FIFO, read through one fixed-size buffer so an
+// unbounded input runs in constant memory. Lines follow MappedInput's rules:
+// a trailing '\n' does not produce an extra empty line and a trailing '\r'
+// is dropped. Reads return whatever the writer has produced so far, so a
+// line is handed out as soon as its '\n' arrives.
+class LineReader {
+public:
+    static constexpr std::size_t default_buffer = std::size_t{1} << 16;
+
+    // "-" reads stdin. Throws when the file cannot be opened.
+    explicit LineReader(const std::filesystem::path &path, std::size_t buffer_size = default_buffer);
+
+    LineReader(const LineReader &) = delete;
+    LineReader &operator=(const LineReader &) = delete;
+    ~LineReader();
+
+    // The next line, valid until the following call; false at end of input.
+    // Throws on a read error or a line longer than the buffer.
+    bool next(std::string_view &line);
+
+    [[nodiscard]] std::size_t lines() const noexcept { return lines_; }
+    [[nodiscard]] std::uint64_t bytes() const noexcept { return bytes_; }
+
+private:
+    // Move the unread tail to the front and append one read; false at EOF.
+    bool refill();
+
+    int fd_{-1};
+    bool owned_{false};
+    std::vector<char> buffer_;
+    std::size_t begin_{0};
+    std::size_t end_{0};
+    bool eof_{false};
+    std::size_t lines_{0};
+    std::uint64_t bytes_{0};
+};
+
+}  // namespace aoc
@@ -0,0 +1,74 @@
+#pragma once
+
+// Scoped trace zones. AOC_ZONE("name") records the enclosing scope's begin/end
+// into a per-thread ring buffer; at exit every buffer is written as Chrome
+// trace-event JSON (chrome://tracing, ui.perfetto.dev). Compiled in only when
+// aoc_common is configured with AOC_TRACE=ON; otherwise the macro expands to
+// nothing.
+
+#if defined(AOC_TRACE)
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace aoc::trace {
+
+struct Event {
+    const char *name;
+    std::int64_t begin_ns;
+    std::int64_t end_ns;
+};
+
+// Single-producer ring: only the owning thread writes, the exit hook reads
+// once every worker is done. When full, the oldest events are overwritten.
+struct ThreadBuffer {
+    static constexpr std::size_t capacity = std::size_t{1} << 16;
+
+    std::array<Event, capacity> events{};
+    std::atomic<std::uint64_t> written{0};
+    std::uint32_t tid{0};
+
+    void push(const Event &e) noexcept {
+        const auto n = written.load(std::memory_order_relaxed);
+        events[n & (capacity - 1)] = e;
+        written.store(n + 1, std::memory_order_release);
+    }
+};
+
+// Buffer of the calling thread (registered on first use).
+ThreadBuffer &thread_buffer();
+
+inline std::int64_t now_ns() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+class Zone {
+public:
+    explicit Zone(const char *name) noexcept : name_(name), begin_(now_ns()) {}
+    Zone(const Zone &) = delete;
+    Zone &operator=(const Zone &) = delete;
+    ~Zone() {
+        const auto end = now_ns();
+        thread_buffer().push(Event{name_, begin_, end});
+    }
+
+private:
+    const char *name_;
+    std::int64_t begin_;
+};
+
+}  // namespace aoc::trace
+
+#define AOC_ZONE_CONCAT_(a, b) a##b
+#define AOC_ZONE_NAME_(line) AOC_ZONE_CONCAT_(aoc_zone_, line)
+#define AOC_ZONE(name) const ::aoc::trace::Zone AOC_ZONE_NAME_(__LINE__){name}
+
+#else
+
+#define AOC_ZONE(name) static_cast<void>(0)
+
+#endif
@@ -0,0 +1,238 @@
+#include "aoc/day.hpp"
+#include "aoc/parallel.hpp"
+#include "aoc/report.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace aoc;
+
+namespace {
+
+struct RunnerOptions {
+    bool parallel{false};                     // --parallel[=N]: days as tasks on the thread pool
+    std::size_t threads{0};                   // N from --parallel=N; 0 = keep options().threads
+    std::optional<std::filesystem::path> input_dir;  // --input-dir=DIR
+    std::vector<int> days;                    // empty = every registered day
+};
+
+// One row of the final table.
+struct Outcome {
+    const DayEntry *entry{nullptr};
+    std::optional<DayResult> result;
+    std::string error;
+    long long wall_micros{0};
+    std::size_t input_bytes{0};
+    std::uint64_t input_hash{0};
+    std::string input;
+};
+
+// "5", "1-9" or "all"
+void add_days(std::vector<int> &days, std::string_view arg) {
+    if (arg == "all") {
+        for (const auto &entry : registered_days()) {
+            days.push_back(entry.day);
+        }
+        return;
+    }
+    const auto dash = arg.find('-');
+    const int first = parse<int>(arg.substr(0, dash));
+    const int last = dash == std::string_view::npos ? first : parse<int>(arg.substr(dash + 1));
+    if (last < first) {
+        throw std::runtime_error("empty day range: " + std::string(arg));
+    }
+    for (int day = first; day <= last; ++day) {
+        days.push_back(day);
+    }
+}
+
+// Strip the runner's own flags and day selectors; the harness flags are
+// left in argv for aoc::init.
+RunnerOptions parse_runner_args(int &argc, char **argv) {
+    RunnerOptions opts;
+    int kept = 1;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg{argv[i]};
+        if (arg == "--parallel") {
+            opts.parallel = true;
+        } else if (arg.starts_with("--parallel=")) {
+            opts.parallel = true;
+            opts.threads = parse<std::size_t>(arg.substr(11));
+        } else if (arg.starts_with("--input-dir=")) {
+            opts.input_dir = std::filesystem::path(arg.substr(12));
+        } else if (!arg.starts_with("--")) {
+            add_days(opts.days, arg);
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    argc = kept;
+    argv[argc] = nullptr;
+    return opts;
+}
+
+std::filesystem::path input_path(const DayEntry &entry, const RunnerOptions &opts) {
+    if (!opts.input_dir) {
+        return entry.default_path;
+    }
+    std::string name = entry.day < 10 ? "day0" : "day";
+    name += std::to_string(entry.day) + ".txt";
+    return *opts.input_dir / name;
+}
+
+void run_one(Outcome &out, const RunnerOptions &opts) {
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        out.input = input_path(*out.entry, opts).string();
+        MappedInput input(out.input);
+        out.input_bytes = input.size();
+        if (options().format != OutputFormat::text) {
+            out.input_hash = hash_input(input.text());
+        }
+        out.result = out.entry->solve(input.lines(), all_parts);
+    } catch (const std::exception &e) {
+        out.error = e.what();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    out.wall_micros = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+// Every day becomes one pool task; the days' own parallel loops share the
+// same workers, so idle threads steal from whichever day still has work.
+void run_parallel(std::vector<Outcome> &outcomes, const RunnerOptions &opts) {
+    parallel_for(0, outcomes.size(), [&](std::size_t i) { run_one(outcomes[i], opts); }, 1);
+}
+
+void print_table(const std::vector<Outcome> &outcomes, long long total_micros, std::size_t threads) {
+    constexpr int w = 12;
+    std::cout << "\nDay " << std::setw(w) << "Parse (us)" << std::setw(w) << "Part 1 (us)"
+              << std::setw(w) << "Part 2 (us)" << std::setw(w) << "Day (us)" << "  Answers\n";
+
+    long long sum_micros{0};
+    for (const auto &out : outcomes) {
+        std::cout << ' ' << std::setw(2) << std::setfill('0') << out.entry->day << std::setfill(' ') << ' ';
+        sum_micros += out.wall_micros;
+        if (!out.result) {
+            std::cout << std::setw(w * 4) << "-" << "  error: " << out.error << "\n";
+            continue;
+        }
+
+        const auto &r = *out.result;
+        std::cout << std::setw(w) << r.parse.micros;
+        for (int part = 1; part <= 2; ++part) {
+            const auto it = std::find_if(r.parts.begin(), r.parts.end(),
+                                         [part](const PartResult &p) { return p.part == part; });
+            if (it != r.parts.end()) {
+                std::cout << std::setw(w) << it->timing.micros;
+            } else {
+                std::cout << std::setw(w) << "-";
+            }
+        }
+        std::cout << std::setw(w) << out.wall_micros << " ";
+        for (const auto &part : r.parts) {
+            std::cout << ' ' << part.answer;
+        }
+        std::cout << "\n";
+    }
+
+    std::cout << "Total wall time: " << total_micros << " us (";
+    if (threads > 1) {
+        std::cout << "days in parallel on " << threads << " threads";
+    } else {
+        std::cout << "days in sequence";
+    }
+    std::cout << ", sum of days " << sum_micros << " us)\n";
+}
+
+// Machine-readable records for every day that finished; failures go to stderr.
+void print_report(const std::vector<Outcome> &outcomes, std::ostream &os) {
+    std::vector<DayReport> reports;
+    for (const auto &out : outcomes) {
+        if (!out.result) {
+            std::cerr << "error: day " << out.entry->day << ": " << out.error << "\n";
+            continue;
+        }
+        reports.push_back(DayReport{
+            .day = out.entry->day,
+            .input_bytes = out.input_bytes,
+            .input_hash = out.input_hash,
+            .input = out.input,
+            .result = *out.result,
+        });
+    }
+    write_report(os, options().format, reports);
+}
+
+}  // namespace
+
+// Runs any subset of the registered days in one process:
+//   aoc_all [all | N | A-B ...] [--parallel[=N]] [--input-dir=DIR] [harness flags]
+int main(int argc, char **argv) {
+    try {
+        RunnerOptions opts = parse_runner_args(argc, argv);
+        init(argc, argv);
+        if (opts.threads != 0) {
+            options().threads = opts.threads;
+        }
+        if (argc > 1) {
+            throw std::runtime_error("unexpected argument: " + std::string(argv[1]));
+        }
+
+        if (opts.days.empty()) {
+            add_days(opts.days, "all");
+        }
+        std::sort(opts.days.begin(), opts.days.end());
+        opts.days.erase(std::unique(opts.days.begin(), opts.days.end()), opts.days.end());
+
+        std::vector<Outcome> outcomes;
+        for (const int day : opts.days) {
+            const DayEntry *entry = find_day(day);
+            if (!entry) {
+                throw std::runtime_error("day " + std::to_string(day) + " is not registered");
+            }
+            outcomes.emplace_back().entry = entry;
+        }
+
+        // Solver debug prints must not end up inside JSON / CSV output
+        std::optional<StdoutToStderr> redirect;
+        if (options().format != OutputFormat::text) {
+            redirect.emplace();
+        }
+
+        const std::size_t threads = opts.parallel ? thread_pool().size() : 1;
+        const auto start = std::chrono::steady_clock::now();
+        if (opts.parallel) {
+            run_parallel(outcomes, opts);
+        } else {
+            for (auto &out : outcomes) {
+                run_one(out, opts);
+            }
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        if (redirect) {
+            print_report(outcomes, redirect->stdout_stream());
+        } else {
+            print_table(outcomes, std::chrono::duration_cast<std::chrono::microseconds>(end - start).count(),
+                        threads);
+        }
+
+        const bool failed = std::any_of(outcomes.begin(), outcomes.end(),
+                                        [](const Outcome &out) { return !out.result; });
+        return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+
+    } catch (const std::exception &e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+// Shared pieces of the aoc_bench kernel benchmarks. Each dayXX_bench.cpp
+// registers its kernels with the Google Benchmark macros; alternatives of
+// one kernel go through BENCHMARK_CAPTURE on the same function so they sort
+// next to each other in the report.
+
+#include "aoc.hpp"
+#include "tools/generators.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aoc::bench {
+
+// A generated input kept alive together with its line index, so the day's
+// own parser can build the kernel's data.
+struct Fixture {
+    std::string text;
+    std::vector<std::string_view> lines;
+
+    [[nodiscard]] Lines view() const noexcept { return lines; }
+};
+
+inline Fixture make_fixture(int day, const gen::GenOptions &given, std::uint64_t seed = 2025) {
+    Fixture fixture;
+    fixture.text = gen::generate_text(day, gen::resolve(day, given), seed);
+    std::string_view rest = fixture.text;
+    while (!rest.empty()) {
+        const auto nl = rest.find('\n');
+        fixture.lines.push_back(rest.substr(0, nl));
+        rest = nl == std::string_view::npos ? std::string_view{} : rest.substr(nl + 1);
+    }
+    return fixture;
+}
+
+// Report items/s and bytes/s from the per-iteration amounts.
+inline void set_throughput(benchmark::State &state, std::int64_t items, std::int64_t bytes) {
+    state.SetItemsProcessed(items * state.iterations());
+    state.SetBytesProcessed(bytes * state.iterations());
+}
+
+}  // namespace aoc::bench
@@ -0,0 +1,63 @@
+#include "bench.hpp"
+#include "days/day01.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <span>
+
+namespace {
+
+// The rotation loop day01 used before run_dial: one rotation at a time,
+// branching on direction and on the wrap.
+long long clicks_stepwise(std::span<const std::int32_t> deltas) {
+    long long count_zero = 0;
+    int dial_pos = day01::dial_start;
+    for (const int delta : deltas) {
+        int value = std::abs(delta);
+        const int factor = delta < 0 ? -1 : 1;
+        if (value > 100) {
+            count_zero += value / 100;
+            value = value % 100;
+        }
+        int new_dial_pos = dial_pos + factor * value;
+        if (std::abs(new_dial_pos) % 100 == 0 || new_dial_pos > 100 || (dial_pos != 0 && new_dial_pos < 0)) {
+            ++count_zero;
+        }
+        if (new_dial_pos < 0) {
+            new_dial_pos += 100;
+        }
+        dial_pos = new_dial_pos % 100;
+    }
+    return count_zero;
+}
+
+long long clicks_blocked(std::span<const std::int32_t> deltas) {
+    return day01::run_dial(deltas).clicks;
+}
+
+// Chunks of 1024 so even the small sizes exercise the shift prefix; runs
+// sequentially on a single-thread pool.
+long long clicks_parallel(std::span<const std::int32_t> deltas) {
+    return day01::run_dial_parallel(deltas, day01::dial_start, 1024).clicks;
+}
+
+// Arg = rotations; one iteration runs the whole log.
+void day01_clicks(benchmark::State &state, long long (*kernel)(std::span<const std::int32_t>)) {
+    const auto fixture = aoc::bench::make_fixture(1, {.size = static_cast<std::uint64_t>(state.range(0))});
+    const auto deltas = day01::parse_deltas(fixture.view());
+    if (kernel(deltas) != clicks_stepwise(deltas)) {
+        state.SkipWithError("disagrees with the stepwise loop");
+        return;
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(kernel(deltas));
+    }
+    aoc::bench::set_throughput(state, state.range(0), static_cast<std::int64_t>(deltas.size() * sizeof(std::int32_t)));
+}
+
+BENCHMARK_CAPTURE(day01_clicks, stepwise, &clicks_stepwise)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK_CAPTURE(day01_clicks, blocked, &clicks_blocked)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK_CAPTURE(day01_clicks, parallel, &clicks_parallel)->RangeMultiplier(16)->Range(1 << 12, 1 << 20)->UseRealTime();
+
+}  // namespace
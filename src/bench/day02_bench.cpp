@@ -0,0 +1,121 @@
+#include "bench.hpp"
+#include "days/day02.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace {
+
+// The original string form of day02::is_invalid_part2: render the value and
+// compare every slice with the first.
+bool is_invalid_part2_string(std::uint64_t value) {
+    const std::string text = std::to_string(value);
+    const std::string_view digits{text};
+    for (std::size_t k = 1; k < digits.size(); ++k) {
+        if (digits.size() % k != 0) {
+            continue;
+        }
+        bool all_match = true;
+        for (std::size_t pos = k; pos < digits.size() && all_match; pos += k) {
+            all_match = digits.substr(pos, k) == digits.substr(0, k);
+        }
+        if (all_match) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Division form of day02::is_invalid_part2: a d-digit value is one k-digit
+// block repeated d/k times exactly when it is a multiple of
+// 1 + 10^k + 10^2k + ... = (10^d - 1) / (10^k - 1).
+bool is_invalid_part2_divide(std::uint64_t value) {
+    constexpr auto pow10 = [] {
+        std::array<std::uint64_t, 11> p{1};
+        for (std::size_t i = 1; i < p.size(); ++i) {
+            p[i] = p[i - 1] * 10;
+        }
+        return p;
+    }();
+    std::size_t digits = 1;
+    while (digits < 10 && value >= pow10[digits]) {
+        ++digits;
+    }
+    for (std::size_t k = 1; k < digits; ++k) {
+        if (digits % k == 0 && value % ((pow10[digits] - 1) / (pow10[k] - 1)) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+constexpr std::int64_t values_per_iteration = 4096;
+
+// Arg = digit count; the block starts at the first value with that many digits.
+void day02_is_invalid_part2(benchmark::State &state, bool (*kernel)(std::uint64_t)) {
+    const auto digits = static_cast<int>(state.range(0));
+    std::uint64_t first = 1;
+    for (int i = 1; i < digits; ++i) {
+        first *= 10;
+    }
+    for (std::uint64_t v = first; v < first + values_per_iteration; ++v) {
+        if (kernel(v) != day02::is_invalid_part2(v)) {
+            state.SkipWithError("disagrees with day02::is_invalid_part2");
+            return;
+        }
+    }
+
+    for (auto _ : state) {
+        long long sum = 0;
+        for (std::uint64_t v = first; v < first + values_per_iteration; ++v) {
+            if (kernel(v)) {
+                sum += static_cast<long long>(v);
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    aoc::bench::set_throughput(state, values_per_iteration, values_per_iteration * digits);
+}
+
+BENCHMARK_CAPTURE(day02_is_invalid_part2, string, &is_invalid_part2_string)->DenseRange(2, 10, 2);
+BENCHMARK_CAPTURE(day02_is_invalid_part2, divide, &is_invalid_part2_divide)->DenseRange(2, 10, 2);
+BENCHMARK_CAPTURE(day02_is_invalid_part2, multiply, &day02::is_invalid_part2)->DenseRange(2, 10, 2);
+
+// Part 2 sum over one range of `width` IDs starting at 10^9 + 1: every value
+// tested in turn, as solve_part2 used to, the same through the batched
+// kernel, or day02::invalid_sum_part2.
+long long scan_sum_part2(day02::Range range) {
+    long long sum = 0;
+    for (std::uint64_t v = range.start; v <= range.end; ++v) {
+        if (day02::is_invalid_part2(v)) {
+            sum += static_cast<long long>(v);
+        }
+    }
+    return sum;
+}
+
+long long kernel_sum_part2(day02::Range range) {
+    return static_cast<long long>(day02::scan_invalid_sum_part2(range));
+}
+
+void day02_range_sum_part2(benchmark::State &state, long long (*engine)(day02::Range)) {
+    const auto width = static_cast<std::uint64_t>(state.range(0));
+    const day02::Range range{1'000'000'001, 1'000'000'000 + width};
+    if (engine(range) != scan_sum_part2(range)) {
+        state.SkipWithError("disagrees with the per-value scan");
+        return;
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(engine(range));
+    }
+    state.SetItemsProcessed(state.range(0) * state.iterations());
+}
+
+BENCHMARK_CAPTURE(day02_range_sum_part2, scan, &scan_sum_part2)->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK_CAPTURE(day02_range_sum_part2, kernel, &kernel_sum_part2)->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK_CAPTURE(day02_range_sum_part2, closed_form, &day02::invalid_sum_part2)->RangeMultiplier(16)->Range(16, 1 << 20);
+
+}  // namespace
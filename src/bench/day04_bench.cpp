@@ -0,0 +1,50 @@
+#include "bench.hpp"
+#include "days/day04.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+using day04::Map;
+
+// The neighbour test one cell at a time, as the day used to run it.
+std::size_t count_per_cell(const Map &map) {
+    std::size_t rolls = 0;
+    for (size_t y = 0; y < map.height(); ++y) {
+        for (size_t x = 0; x < map.width(); ++x) {
+            if (map.get(static_cast<std::ptrdiff_t>(x), static_cast<std::ptrdiff_t>(y)) &&
+                day04::valid_position(map, x, y)) {
+                ++rolls;
+            }
+        }
+    }
+    return rolls;
+}
+
+// 64 cells per operation on the bit planes.
+std::size_t count_per_word(const Map &map) {
+    return day04::accessible_rolls(map).count();
+}
+
+// Arg = grid side; one iteration tests every roll, like part 1.
+void day04_accessible_rolls(benchmark::State &state, std::size_t (*kernel)(const Map &)) {
+    const auto side = static_cast<std::uint64_t>(state.range(0));
+    const auto fixture = aoc::bench::make_fixture(4, {.size = side});
+    const Map map = day04::load_map(fixture.view());
+    if (kernel(map) != count_per_cell(map)) {
+        state.SkipWithError("disagrees with day04::valid_position");
+        return;
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(kernel(map));
+    }
+    const auto cells = static_cast<std::int64_t>(side * side);
+    aoc::bench::set_throughput(state, cells, cells);
+}
+
+BENCHMARK_CAPTURE(day04_accessible_rolls, cell, &count_per_cell)->RangeMultiplier(4)->Range(16, 1024);
+BENCHMARK_CAPTURE(day04_accessible_rolls, word, &count_per_word)->RangeMultiplier(4)->Range(16, 1024);
+
+}  // namespace
@@ -0,0 +1,56 @@
+#include "bench.hpp"
+#include "days/day08.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+using day08::Coord;
+
+double distance_hypot(const Coord &a, const Coord &b) {
+    return a.distance_to(b);
+}
+
+// One sqrt instead of two nested hypot calls; the coordinates are far too
+// small for the squares to overflow, which is all hypot protects against.
+double distance_sqrt(const Coord &a, const Coord &b) {
+    const auto dx = static_cast<double>(a.x) - static_cast<double>(b.x);
+    const auto dy = static_cast<double>(a.y) - static_cast<double>(b.y);
+    const auto dz = static_cast<double>(a.z) - static_cast<double>(b.z);
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+// The solver only compares distances, and squared integers order the same.
+double distance_squared(const Coord &a, const Coord &b) {
+    const auto dx = static_cast<long long>(a.x) - static_cast<long long>(b.x);
+    const auto dy = static_cast<long long>(a.y) - static_cast<long long>(b.y);
+    const auto dz = static_cast<long long>(a.z) - static_cast<long long>(b.z);
+    return static_cast<double>(dx * dx + dy * dy + dz * dz);
+}
+
+// Arg = junction boxes; one iteration covers every pair, like the distance
+// matrix built during parsing.
+void day08_distance_to(benchmark::State &state, double (*kernel)(const Coord &, const Coord &)) {
+    const auto fixture = aoc::bench::make_fixture(8, {.size = static_cast<std::uint64_t>(state.range(0))});
+    const auto coords = day08::parse_input(fixture.view());
+
+    for (auto _ : state) {
+        double sum = 0;
+        for (std::size_t i = 0; i < coords.size(); ++i) {
+            for (std::size_t j = i + 1; j < coords.size(); ++j) {
+                sum += kernel(coords[i], coords[j]);
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    const auto pairs = static_cast<std::int64_t>(coords.size() * (coords.size() - 1) / 2);
+    aoc::bench::set_throughput(state, pairs, pairs * static_cast<std::int64_t>(2 * sizeof(Coord)));
+}
+
+BENCHMARK_CAPTURE(day08_distance_to, hypot, &distance_hypot)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK_CAPTURE(day08_distance_to, sqrt, &distance_sqrt)->RangeMultiplier(4)->Range(64, 4096);
+BENCHMARK_CAPTURE(day08_distance_to, squared, &distance_squared)->RangeMultiplier(4)->Range(64, 4096);
+
+}  // namespace
@@ -0,0 +1,73 @@
+#include "bench.hpp"
+#include "days/day09.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using day09::Coord;
+using day09::Rect;
+
+bool crosses_minmax(const Coord &e1, const Coord &e2, const Rect &r) {
+    return day09::vertical_edge_crosses_interior(e1, e2, r);
+}
+
+// Same test with min < x < max folded into one unsigned compare: x - min - 1
+// wraps around to a huge value whenever x <= min. Degenerate rectangles
+// (min == max) would wrap the bound too, so they are ruled out first.
+bool crosses_wrap(const Coord &e1, const Coord &e2, const Rect &r) {
+    const bool x_inside = r.max_x > r.min_x && e1.x - r.min_x - 1 < r.max_x - r.min_x - 1;
+    const bool below = e1.y <= r.min_y && e2.y <= r.min_y;
+    const bool above = e1.y >= r.max_y && e2.y >= r.max_y;
+    return x_inside && !below && !above;
+}
+
+constexpr std::size_t rects_per_iteration = 256;
+
+// Arg = polygon vertices; one iteration checks every vertical edge against a
+// fixed batch of candidate rectangles, like the inner loop of part 2.
+void day09_vertical_edge_crosses_interior(benchmark::State &state,
+                                          bool (*kernel)(const Coord &, const Coord &, const Rect &)) {
+    const auto fixture = aoc::bench::make_fixture(9, {.size = static_cast<std::uint64_t>(state.range(0))});
+    const auto coords = day09::parse_input(fixture.view());
+
+    std::vector<std::pair<Coord, Coord>> edges;
+    for (std::size_t i = 0; i < coords.size(); ++i) {
+        const Coord &a = coords[i];
+        const Coord &b = coords[(i + 1) % coords.size()];
+        if (a.x == b.x) {
+            edges.emplace_back(a, b);
+        }
+    }
+    std::vector<Rect> rects;
+    for (std::size_t k = 0; k < rects_per_iteration; ++k) {
+        rects.push_back(day09::make_rect(coords[(k * 7919) % coords.size()], coords[(k * 104729 + 1) % coords.size()]));
+    }
+    for (const auto &r : rects) {
+        for (const auto &[a, b] : edges) {
+            if (kernel(a, b, r) != day09::vertical_edge_crosses_interior(a, b, r)) {
+                state.SkipWithError("disagrees with day09::vertical_edge_crosses_interior");
+                return;
+            }
+        }
+    }
+
+    for (auto _ : state) {
+        std::size_t crossings = 0;
+        for (const auto &r : rects) {
+            for (const auto &[a, b] : edges) {
+                crossings += kernel(a, b, r) ? 1U : 0U;
+            }
+        }
+        benchmark::DoNotOptimize(crossings);
+    }
+    const auto tests = static_cast<std::int64_t>(rects.size() * edges.size());
+    aoc::bench::set_throughput(state, tests, tests * static_cast<std::int64_t>(2 * sizeof(Coord)));
+}
+
+BENCHMARK_CAPTURE(day09_vertical_edge_crosses_interior, minmax, &crosses_minmax)->RangeMultiplier(4)->Range(256, 16384);
+BENCHMARK_CAPTURE(day09_vertical_edge_crosses_interior, wrap, &crosses_wrap)->RangeMultiplier(4)->Range(256, 16384);
+
+}  // namespace
@@ -0,0 +1,88 @@
+#include "bench.hpp"
+#include "days/day10.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+// A machine with its groups and pattern also packed as bitsets of lights.
+struct Machine {
+    const day10::Row *row;
+    std::vector<std::uint32_t> group_bits;
+    std::uint32_t pattern_bits{0};
+};
+
+std::vector<Machine> make_machines(const day10::Rows &rows) {
+    std::vector<Machine> machines;
+    for (const auto &row : rows) {
+        Machine m{&row, {}, 0};
+        for (const auto &group : row.groups) {
+            std::uint32_t bits = 0;
+            for (const auto light : group) {
+                bits |= std::uint32_t{1} << light;
+            }
+            m.group_bits.push_back(bits);
+        }
+        for (std::size_t i = 0; i < row.pattern.size(); ++i) {
+            m.pattern_bits |= std::uint32_t{row.pattern[i]} << i;
+        }
+        machines.push_back(std::move(m));
+    }
+    return machines;
+}
+
+int used_groups_vector(const Machine &m, std::uint64_t mask) {
+    return day10::used_groups_if_matches(m.row->groups, m.row->pattern, mask);
+}
+
+// The lights fit in one word, so toggling a group is a single XOR and no
+// scratch vector is allocated per mask.
+int used_groups_bits(const Machine &m, std::uint64_t mask) {
+    std::uint32_t lights = 0;
+    for (std::size_t g = 0; g < m.group_bits.size(); ++g) {
+        if (mask & (std::uint64_t{1} << g)) {
+            lights ^= m.group_bits[g];
+        }
+    }
+    return lights == m.pattern_bits ? std::popcount(mask) : -1;
+}
+
+// Arg = machines; one iteration tries every group subset of every machine,
+// like the brute force of part 1 without its pruning.
+void day10_used_groups_if_matches(benchmark::State &state, int (*kernel)(const Machine &, std::uint64_t)) {
+    const auto fixture = aoc::bench::make_fixture(10, {.size = static_cast<std::uint64_t>(state.range(0))});
+    const auto rows = day10::parse_rows(fixture.view());
+    const auto machines = make_machines(rows);
+
+    std::int64_t masks = 0;
+    for (const auto &m : machines) {
+        const std::uint64_t total = std::uint64_t{1} << m.group_bits.size();
+        masks += static_cast<std::int64_t>(total);
+        for (std::uint64_t mask = 0; mask < total; ++mask) {
+            if (kernel(m, mask) != used_groups_vector(m, mask)) {
+                state.SkipWithError("disagrees with day10::used_groups_if_matches");
+                return;
+            }
+        }
+    }
+
+    for (auto _ : state) {
+        long long matches = 0;
+        for (const auto &m : machines) {
+            const std::uint64_t total = std::uint64_t{1} << m.group_bits.size();
+            for (std::uint64_t mask = 0; mask < total; ++mask) {
+                matches += kernel(m, mask) >= 0 ? 1 : 0;
+            }
+        }
+        benchmark::DoNotOptimize(matches);
+    }
+    aoc::bench::set_throughput(state, masks, masks * static_cast<std::int64_t>(sizeof(std::uint64_t)));
+}
+
+BENCHMARK_CAPTURE(day10_used_groups_if_matches, vector, &used_groups_vector)->RangeMultiplier(4)->Range(8, 128);
+BENCHMARK_CAPTURE(day10_used_groups_if_matches, bits, &used_groups_bits)->RangeMultiplier(4)->Range(8, 128);
+
+}  // namespace
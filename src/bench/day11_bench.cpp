@@ -0,0 +1,111 @@
+#include "bench.hpp"
+#include "days/day11.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+using day11::Graph;
+using day11::Mask;
+
+// The graph with devices interned to dense ids, as a parser could build it
+// once up front.
+struct IndexGraph {
+    std::vector<std::vector<std::uint32_t>> children;
+    std::vector<Mask> target_bit;  // bit cleared when the path visits the device
+    std::uint32_t svr{0};
+    std::uint32_t out{0};
+};
+
+struct Prepared {
+    const Graph *graph;
+    IndexGraph index;
+};
+
+IndexGraph make_index(const Graph &g) {
+    IndexGraph ig;
+    std::unordered_map<std::string, std::uint32_t> ids;
+    const auto id = [&](const std::string &name) {
+        const auto [it, inserted] = ids.try_emplace(name, static_cast<std::uint32_t>(ids.size()));
+        if (inserted) {
+            ig.children.emplace_back();
+            ig.target_bit.push_back(name == "dac" ? Mask{1} : name == "fft" ? Mask{2} : Mask{0});
+        }
+        return it->second;
+    };
+    for (const auto &[name, node] : g) {
+        const auto parent = id(name);
+        for (const auto &child : node.child_l) {
+            const auto c = id(child);
+            ig.children[parent].push_back(c);
+        }
+    }
+    ig.svr = id("svr");
+    ig.out = id("out");
+    return ig;
+}
+
+long long paths_string(const Prepared &p) {
+    day11::DfsContext ctx{*p.graph, {{"dac", 0}, {"fft", 1}}, {}};
+    return day11::find_problematic_paths(ctx, "svr", Mask{3});
+}
+
+long long count_index(const IndexGraph &ig, std::vector<std::array<std::optional<long long>, 4>> &memo, std::uint32_t node,
+                      Mask remaining) {
+    if (node == ig.out) {
+        return remaining == 0 ? 1 : 0;
+    }
+    auto &slot = memo[node][remaining];
+    if (slot) {
+        return *slot;
+    }
+    const auto left = static_cast<Mask>(remaining & ~ig.target_bit[node]);
+    long long count = 0;
+    for (const auto child : ig.children[node]) {
+        count += count_index(ig, memo, child, left);
+    }
+    slot = count;
+    return count;
+}
+
+// Same DFS over dense ids: the memo is a flat array instead of two levels of
+// string-keyed hash maps.
+long long paths_index(const Prepared &p) {
+    // Counts wrap around on big graphs, so no count value can mark "unknown".
+    std::vector<std::array<std::optional<long long>, 4>> memo(p.index.children.size());
+    return count_index(p.index, memo, p.index.svr, Mask{3});
+}
+
+// Arg = devices; one iteration counts the svr -> out paths through dac and
+// fft from a cold memo, like part 2.
+void day11_find_problematic_paths(benchmark::State &state, long long (*kernel)(const Prepared &)) {
+    const auto fixture = aoc::bench::make_fixture(11, {.size = static_cast<std::uint64_t>(state.range(0))});
+    const Graph graph = day11::build_graph(fixture.view());
+    const Prepared prepared{&graph, make_index(graph)};
+    if (kernel(prepared) != paths_string(prepared)) {
+        state.SkipWithError("disagrees with day11::find_problematic_paths");
+        return;
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(kernel(prepared));
+    }
+    std::int64_t edges = 0;
+    for (const auto &[name, node] : graph) {
+        edges += static_cast<std::int64_t>(node.child_l.size());
+    }
+    aoc::bench::set_throughput(state, static_cast<std::int64_t>(graph.size()),
+                               static_cast<std::int64_t>(fixture.text.size()));
+    state.counters["edges"] = static_cast<double>(edges);
+}
+
+BENCHMARK_CAPTURE(day11_find_problematic_paths, string, &paths_string)->RangeMultiplier(4)->Range(128, 8192);
+BENCHMARK_CAPTURE(day11_find_problematic_paths, index, &paths_index)->RangeMultiplier(4)->Range(128, 8192);
+
+}  // namespace
@@ -0,0 +1,48 @@
+#include "bench.hpp"
+
+#include "aoc/dispatch.hpp"
+#include "aoc/scan.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace {
+
+// Arg = junction boxes of a generated day08 input ("x,y,z" lines); one
+// iteration scans the whole text for newlines and commas.
+void scan_delimiters(benchmark::State &state, aoc::ScanKernel kernel, aoc::Isa isa) {
+    if (isa > aoc::host_isa()) {
+        state.SkipWithError("not supported by this CPU");
+        return;
+    }
+    const auto fixture = aoc::bench::make_fixture(8, {.size = static_cast<std::uint64_t>(state.range(0))});
+
+    aoc::DelimiterOffsets expected;
+    aoc::DelimiterOffsets out;
+    aoc::scan_versions().front().fn(fixture.text, aoc::newline | aoc::comma, expected);
+    kernel(fixture.text, aoc::newline | aoc::comma, out);
+    if (out.fields != expected.fields || out.lines != expected.lines) {
+        state.SkipWithError("disagrees with the scalar scan");
+        return;
+    }
+
+    for (auto _ : state) {
+        out.clear();
+        kernel(fixture.text, aoc::newline | aoc::comma, out);
+        benchmark::DoNotOptimize(out.fields.data());
+    }
+    const auto bytes = static_cast<std::int64_t>(fixture.text.size());
+    aoc::bench::set_throughput(state, bytes, bytes);
+}
+
+// One benchmark per compiled version, named after its ISA, whatever the
+// host picks by default.
+const bool registered = [] {
+    for (const auto &version : aoc::scan_versions()) {
+        const std::string name = std::string("scan_delimiters/") + aoc::isa_name(version.isa);
+        benchmark::RegisterBenchmark(name.c_str(), scan_delimiters, version.fn, version.isa)->Arg(1000)->Arg(100000);
+    }
+    return true;
+}();
+
+}  // namespace
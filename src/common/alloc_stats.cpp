@@ -0,0 +1,113 @@
+// Replacement global operator new/delete that feed aoc::alloc_counters().
+// Only compiled into aoc_common when AOC_ALLOC_STATS is ON.
+#include "aoc/alloc.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#define AOC_USABLE_SIZE(p) malloc_size(p)
+#else
+#include <malloc.h>
+#define AOC_USABLE_SIZE(p) malloc_usable_size(p)
+#endif
+
+namespace {
+
+std::atomic<std::uint64_t> g_allocations{0};
+std::atomic<std::uint64_t> g_bytes{0};
+std::atomic<std::uint64_t> g_live{0};
+std::atomic<std::uint64_t> g_peak{0};
+
+void on_alloc(void *p, std::size_t requested) noexcept {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_bytes.fetch_add(requested, std::memory_order_relaxed);
+    // Live bytes use the usable size so alloc and free agree without a header.
+    const std::uint64_t live = g_live.fetch_add(AOC_USABLE_SIZE(p), std::memory_order_relaxed) + AOC_USABLE_SIZE(p);
+    std::uint64_t peak = g_peak.load(std::memory_order_relaxed);
+    while (live > peak && !g_peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+}
+
+void on_free(void *p) noexcept {
+    if (p != nullptr) {
+        g_live.fetch_sub(AOC_USABLE_SIZE(p), std::memory_order_relaxed);
+    }
+}
+
+void *counted_alloc(std::size_t size) noexcept {
+    void *p = std::malloc(size == 0 ? 1 : size);
+    if (p != nullptr) {
+        on_alloc(p, size);
+    }
+    return p;
+}
+
+void *counted_aligned_alloc(std::size_t size, std::align_val_t align) noexcept {
+    const auto a = static_cast<std::size_t>(align);
+    const std::size_t rounded = ((size == 0 ? 1 : size) + a - 1) / a * a;
+    void *p = std::aligned_alloc(a, rounded);
+    if (p != nullptr) {
+        on_alloc(p, size);
+    }
+    return p;
+}
+
+void *throwing(void *p) {
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void counted_free(void *p) noexcept {
+    on_free(p);
+    std::free(p);
+}
+
+}  // namespace
+
+namespace aoc {
+
+AllocCounters alloc_counters() noexcept {
+    return AllocCounters{
+        .allocations = g_allocations.load(std::memory_order_relaxed),
+        .bytes = g_bytes.load(std::memory_order_relaxed),
+        .live_bytes = g_live.load(std::memory_order_relaxed),
+        .peak_live_bytes = g_peak.load(std::memory_order_relaxed),
+    };
+}
+
+void reset_alloc_peak() noexcept {
+    g_peak.store(g_live.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+}  // namespace aoc
+
+void *operator new(std::size_t size) { return throwing(counted_alloc(size)); }
+void *operator new[](std::size_t size) { return throwing(counted_alloc(size)); }
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept { return counted_alloc(size); }
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept { return counted_alloc(size); }
+void *operator new(std::size_t size, std::align_val_t align) { return throwing(counted_aligned_alloc(size, align)); }
+void *operator new[](std::size_t size, std::align_val_t align) { return throwing(counted_aligned_alloc(size, align)); }
+void *operator new(std::size_t size, std::align_val_t align, const std::nothrow_t &) noexcept {
+    return counted_aligned_alloc(size, align);
+}
+void *operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t &) noexcept {
+    return counted_aligned_alloc(size, align);
+}
+
+void operator delete(void *p) noexcept { counted_free(p); }
+void operator delete[](void *p) noexcept { counted_free(p); }
+void operator delete(void *p, std::size_t) noexcept { counted_free(p); }
+void operator delete[](void *p, std::size_t) noexcept { counted_free(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept { counted_free(p); }
+void operator delete[](void *p, const std::nothrow_t &) noexcept { counted_free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { counted_free(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { counted_free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { counted_free(p); }
+void operator delete[](void *p, std::size_t, std::align_val_t) noexcept { counted_free(p); }
+void operator delete(void *p, std::align_val_t, const std::nothrow_t &) noexcept { counted_free(p); }
+void operator delete[](void *p, std::align_val_t, const std::nothrow_t &) noexcept { counted_free(p); }
@@ -0,0 +1,125 @@
+#include "aoc/answer_cache.hpp"
+
+#include "aoc/log.hpp"
+#include "aoc/model_cache.hpp"
+
+#include <array>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <mach-o/dyld.h>
+#endif
+
+namespace aoc {
+
+namespace {
+
+// The running executable; empty when the platform has no way to ask.
+std::filesystem::path executable_path() {
+#if defined(__linux__)
+    return "/proc/self/exe";
+#elif defined(_WIN32)
+    std::vector<wchar_t> path(32768);
+    const DWORD n = ::GetModuleFileNameW(nullptr, path.data(), static_cast<DWORD>(path.size()));
+    return n == 0 || n == path.size() ? std::filesystem::path{} : std::filesystem::path(path.data(), path.data() + n);
+#elif defined(__APPLE__)
+    std::vector<char> path(4096);
+    auto size = static_cast<std::uint32_t>(path.size());
+    return ::_NSGetExecutablePath(path.data(), &size) == 0 ? std::filesystem::path(path.data()) : std::filesystem::path{};
+#else
+    return {};
+#endif
+}
+
+std::optional<std::uint64_t> hash_executable() {
+    const auto path = executable_path();
+    std::ifstream in(path, std::ios::binary);
+    if (path.empty() || !in) {
+        return std::nullopt;
+    }
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    std::vector<char> chunk(std::size_t{1} << 16);
+    while (in) {
+        in.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+        const auto n = static_cast<std::size_t>(in.gcount());
+        for (std::size_t i = 0; i < n; ++i) {
+            hash ^= static_cast<unsigned char>(chunk[i]);
+            hash *= 0x100000001b3ULL;
+        }
+    }
+    if (!in.eof()) {
+        return std::nullopt;
+    }
+    return hash;
+}
+
+std::filesystem::path answer_path(const AnswerKey &key, int part) {
+    std::array<char, 96> name{};
+    std::snprintf(name.data(), name.size(), "day%02d-p%d-v%u-%016llx-%016llx.answer", key.day, part,
+                  key.solver_version, static_cast<unsigned long long>(key.build),
+                  static_cast<unsigned long long>(key.input_hash));
+    return std::filesystem::path(options().answer_cache) / name.data();
+}
+
+// First line of an entry; repeating the key inside the file guards against
+// hand-copied or renamed files.
+std::string answer_header(const AnswerKey &key, int part) {
+    std::array<char, 128> line{};
+    std::snprintf(line.data(), line.size(), "AOCANS 1 day=%d part=%d version=%u build=%016llx input=%016llx\n",
+                  key.day, part, key.solver_version, static_cast<unsigned long long>(key.build),
+                  static_cast<unsigned long long>(key.input_hash));
+    return line.data();
+}
+
+}  // namespace
+
+std::optional<std::uint64_t> binary_id() noexcept {
+    static const std::optional<std::uint64_t> id = [] {
+        try {
+            return hash_executable();
+        } catch (const std::exception &) {
+            return std::optional<std::uint64_t>{};
+        }
+    }();
+    return id;
+}
+
+bool answer_cache_enabled() noexcept {
+    if (options().answer_cache.empty() || options().no_cache) {
+        return false;
+    }
+    static const bool identified = [] {
+        if (!binary_id()) {
+            AOC_LOG(warn, "--answer-cache is off: this executable could not be read to identify the build");
+        }
+        return binary_id().has_value();
+    }();
+    return identified;
+}
+
+std::optional<std::string> load_answer(const AnswerKey &key, int part) {
+    std::ifstream in(answer_path(key, part), std::ios::binary);
+    if (!in) {
+        return std::nullopt;
+    }
+    const std::string text{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    const auto header = answer_header(key, part);
+    if (!text.starts_with(header) || text.size() == header.size()) {
+        return std::nullopt;
+    }
+    return text.substr(header.size());
+}
+
+void store_answer(const AnswerKey &key, int part, std::string_view answer) {
+    write_file_atomically(answer_path(key, part), answer_header(key, part), answer);
+}
+
+}  // namespace aoc
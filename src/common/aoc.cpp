@@ -1,3 +1,231 @@
 #include "aoc.hpp"
 
-// Currently everything is inline in the header.
\ No newline at end of file
+#include "aoc/dispatch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <numeric>
+#include <string>
+#include <string_view>
+
+namespace aoc {
+
+namespace {
+
+std::size_t parse_count(std::string_view what, std::string_view value) {
+    try {
+        return parse<std::size_t>(value);
+    } catch (const std::exception &) {
+        throw std::runtime_error("invalid value for " + std::string(what) + ": '" + std::string(value) + "'");
+    }
+}
+
+// On/off flags and their environment variables: "--perf", "--perf=1" and
+// AOC_PERF=1 turn the option on, "--perf=0" and AOC_PERF=0 turn it off.
+bool parse_switch(std::string_view value) {
+    return value != "0";
+}
+
+OutputFormat parse_format(std::string_view value) {
+    if (value == "text") {
+        return OutputFormat::text;
+    }
+    if (value == "json") {
+        return OutputFormat::json;
+    }
+    if (value == "csv") {
+        return OutputFormat::csv;
+    }
+    throw std::runtime_error("unknown output format: '" + std::string(value) + "' (expected text, json or csv)");
+}
+
+std::string checked_isa(std::string_view value) {
+    if (!parse_isa(value)) {
+        throw std::runtime_error("unknown ISA: '" + std::string(value) +
+                                 "' (expected scalar, sse2, sse4.2, avx2 or avx512)");
+    }
+    return std::string(value);
+}
+
+LogLevel parse_level(std::string_view value) {
+    const auto level = parse_log_level(value);
+    if (!level) {
+        throw std::runtime_error("unknown log level: '" + std::string(value) +
+                                 "' (expected error, warn, info, debug or trace)");
+    }
+    if (*level > compiled_log_level) {
+        std::cerr << "warning: log level " << value << " is compiled out, build with -DAOC_LOG_LEVEL=" << value
+                  << " to see it\n";
+    }
+    return *level;
+}
+
+void apply_env(Options &opts) {
+    if (const char *bench = std::getenv("AOC_BENCH")) {
+        opts.bench_runs = parse_count("AOC_BENCH", bench);
+    }
+    if (const char *warmup = std::getenv("AOC_WARMUP")) {
+        opts.warmup_runs = parse_count("AOC_WARMUP", warmup);
+    }
+    if (const char *perf = std::getenv("AOC_PERF")) {
+        opts.perf = parse_switch(perf);
+    }
+    if (const char *trace = std::getenv("AOC_TRACE_FILE")) {
+        opts.trace_path = trace;
+    }
+    if (const char *threads = std::getenv("AOC_THREADS")) {
+        opts.threads = parse_count("AOC_THREADS", threads);
+    }
+    if (const char *pin = std::getenv("AOC_PIN")) {
+        opts.pin = parse_switch(pin);
+    }
+    if (const char *format = std::getenv("AOC_FORMAT")) {
+        opts.format = parse_format(format);
+    }
+    if (const char *model_cache = std::getenv("AOC_MODEL_CACHE")) {
+        opts.model_cache = model_cache;
+    }
+    if (const char *answer_cache = std::getenv("AOC_ANSWER_CACHE")) {
+        opts.answer_cache = answer_cache;
+    }
+    if (const char *isa = std::getenv("AOC_ISA")) {
+        opts.isa = checked_isa(isa);
+    }
+    if (const char *log = std::getenv("AOC_LOG")) {
+        opts.log_level = parse_level(log);
+    }
+    if (const char *in_flight = std::getenv("AOC_IN_FLIGHT")) {
+        opts.in_flight = parse_count("AOC_IN_FLIGHT", in_flight);
+    }
+    if (const char *stream = std::getenv("AOC_STREAM")) {
+        opts.stream = parse_switch(stream);
+    }
+    if (const char *every = std::getenv("AOC_STREAM_EVERY")) {
+        opts.stream_every = parse_count("AOC_STREAM_EVERY", every);
+    }
+}
+
+constexpr std::size_t default_bench_runs = 100;
+constexpr std::string_view default_cache_dir = ".aoc-cache";
+
+}  // namespace
+
+Options &options() noexcept {
+    static Options opts;
+    return opts;
+}
+
+void init(int &argc, char **argv) {
+    auto &opts = options();
+    apply_env(opts);
+
+    int kept = 1;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg{argv[i]};
+        if (!arg.starts_with("--")) {
+            argv[kept++] = argv[i];
+            continue;
+        }
+
+        const auto eq = arg.find('=');
+        const std::string_view name = arg.substr(0, eq);
+        const std::string_view value = eq == std::string_view::npos ? std::string_view{} : arg.substr(eq + 1);
+
+        if (name == "--bench") {
+            opts.bench_runs = value.empty() ? default_bench_runs : parse_count(name, value);
+        } else if (name == "--warmup") {
+            opts.warmup_runs = parse_count(name, value);
+        } else if (name == "--perf") {
+            opts.perf = parse_switch(value);
+        } else if (name == "--trace") {
+#if !defined(AOC_TRACE)
+            std::cerr << "warning: --trace ignored, build with -DAOC_TRACE=ON to record zones\n";
+#endif
+            if (!value.empty()) {
+                opts.trace_path = std::string(value);
+            }
+        } else if (name == "--threads") {
+            opts.threads = parse_count(name, value);
+        } else if (name == "--pin") {
+            opts.pin = parse_switch(value);
+        } else if (name == "--format") {
+            opts.format = parse_format(value);
+        } else if (name == "--model-cache") {
+            opts.model_cache = value.empty() ? std::string(default_cache_dir) : std::string(value);
+        } else if (name == "--answer-cache") {
+            opts.answer_cache = value.empty() ? std::string(default_cache_dir) : std::string(value);
+        } else if (name == "--no-cache") {
+            opts.no_cache = parse_switch(value);
+        } else if (name == "--verify-cache") {
+            opts.verify_cache = parse_switch(value);
+        } else if (name == "--isa") {
+            opts.isa = checked_isa(value);
+        } else if (name == "--log") {
+            opts.log_level = parse_level(value);
+        } else if (name == "--in-flight") {
+            opts.in_flight = parse_count(name, value);
+        } else if (name == "--stream") {
+            opts.stream = parse_switch(value);
+        } else if (name == "--every") {
+            opts.stream_every = parse_count(name, value);
+        } else {
+            throw std::runtime_error("unknown option: " + std::string(arg));
+        }
+    }
+    argc = kept;
+    argv[argc] = nullptr;
+}
+
+BenchStats summarize(std::vector<long long> samples_ns) {
+    BenchStats stats;
+    stats.runs = samples_ns.size();
+    if (samples_ns.empty()) {
+        return stats;
+    }
+
+    std::sort(samples_ns.begin(), samples_ns.end());
+    const std::size_t n = samples_ns.size();
+    stats.min_ns = samples_ns.front();
+    stats.median_ns = n % 2 == 1 ? samples_ns[n / 2] : (samples_ns[n / 2 - 1] + samples_ns[n / 2]) / 2;
+    // nearest-rank percentile
+    const auto p99_rank = static_cast<std::size_t>(std::ceil(0.99 * static_cast<double>(n)));
+    stats.p99_ns = samples_ns[std::max<std::size_t>(p99_rank, 1) - 1];
+
+    const double mean = std::accumulate(samples_ns.begin(), samples_ns.end(), 0.0) / static_cast<double>(n);
+    double sq{0.0};
+    for (const auto s : samples_ns) {
+        const double d = static_cast<double>(s) - mean;
+        sq += d * d;
+    }
+    stats.mean_ns = std::llround(mean);
+    stats.stddev_ns = n > 1 ? std::sqrt(sq / static_cast<double>(n - 1)) : 0.0;
+    return stats;
+}
+
+void print_bench(const BenchStats &stats) {
+    std::cout << "  bench: " << stats.runs << " runs, min " << stats.min_ns
+              << " ns, median " << stats.median_ns
+              << " ns, mean " << stats.mean_ns
+              << " ns, p99 " << stats.p99_ns
+              << " ns, stddev " << std::llround(stats.stddev_ns) << " ns\n";
+}
+
+void print_details(const Timing &timing) {
+    if (timing.bench) {
+        print_bench(*timing.bench);
+    }
+    if (timing.perf) {
+        print_perf(*timing.perf, options().input_bytes);
+    }
+    if (timing.alloc) {
+        print_alloc(*timing.alloc);
+    }
+}
+
+void print_alloc(const AllocStats &stats) {
+    std::cout << "  alloc: " << stats.allocations << " allocations, "
+              << stats.bytes << " bytes, peak " << stats.peak_bytes << " live bytes\n";
+}
+
+}  // namespace aoc
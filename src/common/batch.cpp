@@ -0,0 +1,171 @@
+#include "aoc/batch.hpp"
+
+#include "aoc/parallel.hpp"
+#include "aoc/report.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+
+namespace aoc {
+
+namespace {
+
+struct Slot {
+    BatchFile file;
+    std::atomic<bool> finished{false};
+};
+
+void solve_file(const DayEntry &entry, BatchFile &file, bool hash) {
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        MappedInput input(file.path);
+        file.input_bytes = input.size();
+        if (hash) {
+            file.input_hash = hash_input(input.text());
+        }
+        file.result = entry.solve(input.lines(), all_parts);
+    } catch (const std::exception &e) {
+        file.error = e.what();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    file.wall_micros = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+}  // namespace
+
+std::vector<std::filesystem::path> batch_inputs(const std::filesystem::path &source, bool manifest) {
+    std::vector<std::filesystem::path> inputs;
+    if (!manifest) {
+        for (const auto &item : std::filesystem::directory_iterator(source)) {
+            if (item.is_regular_file()) {
+                inputs.push_back(item.path());
+            }
+        }
+        std::sort(inputs.begin(), inputs.end());
+        return inputs;
+    }
+
+    std::ifstream in(source);
+    if (!in) {
+        throw std::runtime_error("cannot open manifest: " + source.string());
+    }
+    const auto base = source.parent_path();
+    std::string line;
+    while (std::getline(in, line)) {
+        const auto text = trim(line);
+        if (text.empty() || text.front() == '#') {
+            continue;
+        }
+        const std::filesystem::path path{text};
+        inputs.push_back(path.is_absolute() ? path : base / path);
+    }
+    return inputs;
+}
+
+BatchStats run_batch(const DayEntry &entry, std::span<const std::filesystem::path> inputs, std::size_t in_flight,
+                     bool hash, const std::function<void(const BatchFile &)> &done) {
+    auto &pool = thread_pool();
+    BatchStats stats;
+    stats.threads = pool.size();
+    stats.in_flight = in_flight != 0 ? in_flight : 2 * pool.size();
+
+    const auto start = std::chrono::steady_clock::now();
+    {
+        // Slots are reported and freed from the front; the calling thread
+        // helps run tasks while it waits, which also makes a single-thread
+        // pool work through the window inline. The window outlives the
+        // group: when done() throws, ~TaskGroup still finishes the spawned
+        // tasks, and they write into their slots.
+        std::deque<std::unique_ptr<Slot>> window;
+        TaskGroup group(pool);
+        std::size_t next = 0;
+        while (next < inputs.size() || !window.empty()) {
+            while (next < inputs.size() && window.size() < stats.in_flight) {
+                auto &slot = *window.emplace_back(std::make_unique<Slot>());
+                slot.file.path = inputs[next++];
+                group.spawn([&entry, &slot, hash] {
+                    solve_file(entry, slot.file, hash);
+                    slot.finished.store(true, std::memory_order_release);
+                });
+            }
+            if (window.front()->finished.load(std::memory_order_acquire)) {
+                const BatchFile &file = window.front()->file;
+                ++stats.files;
+                stats.failed += file.result ? 0U : 1U;
+                stats.bytes += file.input_bytes;
+                done(file);
+                window.pop_front();
+            } else if (!pool.run_one()) {
+                std::this_thread::yield();
+            }
+        }
+        group.wait();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    stats.wall_micros = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    return stats;
+}
+
+void print_batch_stats(const BatchStats &stats) {
+    const double seconds = static_cast<double>(std::max<long long>(stats.wall_micros, 1)) / 1e6;
+    const double mb = static_cast<double>(stats.bytes) / 1e6;
+    std::cout << "Batch: " << stats.files << " files (" << stats.failed << " failed), " << std::fixed
+              << std::setprecision(1) << mb << " MB in " << static_cast<double>(stats.wall_micros) / 1000.0
+              << " ms on " << stats.threads << " threads: " << static_cast<double>(stats.files) / seconds
+              << " files/s, " << mb / seconds << " MB/s (at most " << stats.in_flight << " inputs in flight)\n";
+    std::cout << std::defaultfloat;
+}
+
+int run_day_batch(const DayEntry &entry, const std::filesystem::path &source, bool manifest) {
+    const auto inputs = batch_inputs(source, manifest);
+    const auto format = options().format;
+
+    if (format == OutputFormat::text) {
+        const auto stats = run_batch(entry, inputs, options().in_flight, false, [](const BatchFile &file) {
+            std::cout << file.path.string() << ":";
+            if (!file.result) {
+                std::cout << " error: " << file.error << "\n";
+                return;
+            }
+            for (const auto &p : file.result->parts) {
+                std::cout << ' ' << p.answer;
+            }
+            std::cout << " (" << file.wall_micros << " us)\n";
+        });
+        print_batch_stats(stats);
+        return stats.failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // Records are kept small (no input text), so collecting them is fine
+    // even for long batches; throughput goes to stderr with the solver noise.
+    StdoutToStderr redirect;
+    std::vector<DayReport> reports;
+    const auto stats = run_batch(entry, inputs, options().in_flight, true, [&](const BatchFile &file) {
+        if (!file.result) {
+            std::cerr << "error: " << file.path.string() << ": " << file.error << "\n";
+            return;
+        }
+        reports.push_back(DayReport{
+            .day = entry.day,
+            .input_bytes = file.input_bytes,
+            .input_hash = file.input_hash,
+            .input = file.path.string(),
+            .result = *file.result,
+        });
+    });
+    print_batch_stats(stats);
+    write_report(redirect.stdout_stream(), format, reports);
+    return stats.failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+}  // namespace aoc
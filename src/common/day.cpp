@@ -0,0 +1,131 @@
+#include "aoc/day.hpp"
+
+#include "aoc/batch.hpp"
+#include "aoc/report.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace aoc {
+
+namespace {
+
+// Function-local so registration from other translation units' static
+// initializers never sees an unconstructed vector.
+std::vector<DayEntry> &registry() {
+    static std::vector<DayEntry> days;
+    return days;
+}
+
+}  // namespace
+
+void register_day(const DayEntry &entry) {
+    auto &days = registry();
+    const auto it = std::lower_bound(days.begin(), days.end(), entry.day,
+                                     [](const DayEntry &e, int day) { return e.day < day; });
+    if (it != days.end() && it->day == entry.day) {
+        throw std::runtime_error("day " + std::to_string(entry.day) + " registered twice");
+    }
+    days.insert(it, entry);
+}
+
+std::span<const DayEntry> registered_days() {
+    return registry();
+}
+
+const DayEntry *find_day(int day) {
+    for (const auto &entry : registry()) {
+        if (entry.day == day) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+void print_day(const DayResult &result) {
+    if (result.answers_cached) {
+        std::cout << "Parse: skipped (cached answers)\n";
+    } else {
+        std::cout << "Parse: (" << result.parse.micros << " us" << (result.model_cached ? ", cached model" : "")
+                  << ")\n";
+        print_details(result.parse);
+    }
+
+    for (const auto &p : result.parts) {
+        print_answer(p.part, p.answer, p.timing);
+    }
+}
+
+void print_running(std::size_t lines, const std::vector<PartResult> &parts) {
+    std::cout << "Lines " << lines << ":";
+    for (const auto &p : parts) {
+        std::cout << (p.part == 1 ? " " : ", ") << "part " << p.part << " = " << p.answer;
+    }
+    std::cout << std::endl;
+}
+
+namespace {
+
+int run_day_stream(const DayEntry &entry, const std::string &input_path) {
+    if (entry.stream == nullptr) {
+        throw std::runtime_error("day " + std::to_string(entry.day) + " cannot read its input as a stream");
+    }
+    if (options().format != OutputFormat::text) {
+        throw std::runtime_error("streamed input only supports --format=text");
+    }
+    LineReader input(input_path);
+    const auto result = entry.stream(input, options().stream_every);
+    std::cout << "Stream: " << input.lines() << " lines, " << input.bytes() << " bytes (" << result.parse.micros
+              << " us)\n";
+    for (const auto &p : result.parts) {
+        print_answer(p.part, p.answer, p.timing);
+    }
+    return EXIT_SUCCESS;
+}
+
+}  // namespace
+
+int run_day(const DayEntry &entry, int argc, char **argv) {
+    try {
+        init(argc, argv);
+        const std::string input_path = argc > 1 ? argv[1] : std::string(entry.default_path);
+        if (input_path.starts_with('@')) {
+            return run_day_batch(entry, input_path.substr(1), true);
+        }
+        if (std::filesystem::is_directory(input_path)) {
+            return run_day_batch(entry, input_path, false);
+        }
+        if (options().stream || input_path == "-" || std::filesystem::is_fifo(input_path)) {
+            return run_day_stream(entry, input_path);
+        }
+        MappedInput input(input_path);
+        options().input_bytes = input.size();
+
+        const auto format = options().format;
+        if (format == OutputFormat::text) {
+            print_day(entry.solve(input.lines(), all_parts));
+        } else {
+            StdoutToStderr redirect;
+            const DayReport report{
+                .day = entry.day,
+                .input_bytes = input.size(),
+                .input_hash = hash_input(input.text()),
+                .input = input_path,
+                .result = entry.solve(input.lines(), all_parts),
+            };
+            write_report(redirect.stdout_stream(), format, {&report, 1});
+        }
+
+    } catch (const std::exception &e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+}  // namespace aoc
@@ -0,0 +1,14 @@
+#include "aoc/day.hpp"
+
+#include <cstdlib>
+#include <iostream>
+
+// Entry point of the per-day binaries: each links exactly one day object.
+int main(int argc, char **argv) {
+    const auto days = aoc::registered_days();
+    if (days.size() != 1) {
+        std::cerr << "Error: expected one registered day, found " << days.size() << "\n";
+        return EXIT_FAILURE;
+    }
+    return aoc::run_day(days.front(), argc, argv);
+}
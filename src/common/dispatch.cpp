@@ -0,0 +1,87 @@
+#include "aoc/dispatch.hpp"
+
+#include "aoc.hpp"
+
+#include <array>
+#include <iostream>
+#include <utility>
+
+namespace aoc {
+
+namespace {
+
+constexpr std::array<std::pair<Isa, const char *>, 5> isa_names{{
+    {Isa::scalar, "scalar"},
+    {Isa::sse2, "sse2"},
+    {Isa::sse42, "sse4.2"},
+    {Isa::avx2, "avx2"},
+    {Isa::avx512, "avx512"},
+}};
+
+Isa detect_host() noexcept {
+#if defined(AOC_DISPATCH_X86)
+    __builtin_cpu_init();
+    // The AVX-512 kernels use byte and word lanes, so F alone is not enough.
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+        __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("avx512dq")) {
+        return Isa::avx512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi2") && __builtin_cpu_supports("fma")) {
+        return Isa::avx2;
+    }
+    if (__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt")) {
+        return Isa::sse42;
+    }
+    return __builtin_cpu_supports("sse2") ? Isa::sse2 : Isa::scalar;
+#else
+    return Isa::scalar;
+#endif
+}
+
+Isa pick_active() noexcept {
+    const Isa host = host_isa();
+    const auto &name = options().isa;
+    if (name.empty()) {
+        return host;
+    }
+    // init() already rejected unknown names.
+    const Isa wanted = parse_isa(name).value_or(host);
+    if (wanted > host) {
+        std::cerr << "warning: --isa=" << name << " is not supported by this CPU, using " << isa_name(host)
+                  << "\n";
+        return host;
+    }
+    return wanted;
+}
+
+}  // namespace
+
+const char *isa_name(Isa isa) noexcept {
+    for (const auto &[value, name] : isa_names) {
+        if (value == isa) {
+            return name;
+        }
+    }
+    return "unknown";
+}
+
+std::optional<Isa> parse_isa(std::string_view name) noexcept {
+    for (const auto &[value, text] : isa_names) {
+        if (name == text) {
+            return value;
+        }
+    }
+    return std::nullopt;
+}
+
+Isa host_isa() noexcept {
+    static const Isa host = detect_host();
+    return host;
+}
+
+Isa active_isa() noexcept {
+    static const Isa active = pick_active();
+    return active;
+}
+
+}  // namespace aoc
@@ -0,0 +1,50 @@
+#include "aoc/grid.hpp"
+
+#include <bit>
+#include <string>
+
+namespace aoc {
+
+GridView<const char> text_grid(Lines lines) {
+    GridView<const char> view;
+    if (lines.empty()) {
+        return view;
+    }
+    view.data = lines.front().data();
+    view.width = lines.front().size();
+    view.height = lines.size();
+    view.stride = lines.size() > 1 ? static_cast<std::size_t>(lines[1].data() - lines[0].data()) : view.width;
+    for (std::size_t y = 0; y < lines.size(); ++y) {
+        if (lines[y].size() != view.width) {
+            throw std::runtime_error("grid row " + std::to_string(y) + " has width " +
+                                     std::to_string(lines[y].size()) + ", expected " + std::to_string(view.width));
+        }
+        if (lines[y].data() != view.data + y * view.stride) {
+            throw std::runtime_error("grid rows are not evenly spaced in one buffer");
+        }
+    }
+    return view;
+}
+
+BitGrid::BitGrid(std::size_t width, std::size_t height)
+    : width_(width), height_(height), words_((width + word_bits - 1) / word_bits), stride_(words_ + 1),
+      words_data_((height + 2) * stride_ + 1, 0) {}
+
+void BitGrid::set(std::size_t x, std::size_t y, bool value) noexcept {
+    Word &word = row(static_cast<std::ptrdiff_t>(y))[x / word_bits];
+    const Word bit = Word{1} << (x % word_bits);
+    word = value ? (word | bit) : (word & ~bit);
+}
+
+std::size_t BitGrid::count() const noexcept {
+    std::size_t total = 0;
+    for (std::size_t y = 0; y < height_; ++y) {
+        const Word *words = row(static_cast<std::ptrdiff_t>(y));
+        for (std::size_t k = 0; k < words_; ++k) {
+            total += static_cast<std::size_t>(std::popcount(words[k]));
+        }
+    }
+    return total;
+}
+
+}  // namespace aoc
@@ -0,0 +1,57 @@
+#include "aoc/log.hpp"
+
+#include "aoc.hpp"
+
+#include <array>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace aoc {
+
+namespace {
+
+constexpr std::array<std::pair<LogLevel, const char *>, 5> level_names{{
+    {LogLevel::error, "error"},
+    {LogLevel::warn, "warn"},
+    {LogLevel::info, "info"},
+    {LogLevel::debug, "debug"},
+    {LogLevel::trace, "trace"},
+}};
+
+}  // namespace
+
+const char *log_level_name(LogLevel level) noexcept {
+    for (const auto &[value, name] : level_names) {
+        if (value == level) {
+            return name;
+        }
+    }
+    return "unknown";
+}
+
+std::optional<LogLevel> parse_log_level(std::string_view name) noexcept {
+    for (const auto &[value, text] : level_names) {
+        if (name == text) {
+            return value;
+        }
+    }
+    return std::nullopt;
+}
+
+bool log_enabled(LogLevel level) noexcept {
+    return level <= options().log_level;
+}
+
+void log_line(LogLevel level, std::string_view text) {
+    static std::mutex mutex;
+    std::string line = log_level_name(level);
+    line += ": ";
+    line += text;
+    line += '\n';
+    const std::lock_guard lock(mutex);
+    std::cerr << line << std::flush;
+}
+
+}  // namespace aoc
@@ -0,0 +1,174 @@
+#include "aoc/model_cache.hpp"
+
+#include <array>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace aoc {
+
+namespace {
+
+constexpr std::array<char, 8> magic{'A', 'O', 'C', 'B', 'I', 'N', '\0', '\0'};
+constexpr std::uint32_t format_version = 1;
+
+// Fixed-size file header; the payload follows at offset sizeof(Header),
+// which keeps it 8-byte aligned in the mapping.
+struct Header {
+    std::array<char, 8> magic;
+    std::uint32_t format;
+    std::uint32_t day;
+    std::uint32_t version;
+    std::uint32_t reserved;
+    std::uint64_t input_hash;
+    std::uint64_t payload_bytes;
+};
+static_assert(sizeof(Header) == 40 && std::is_trivially_copyable_v<Header>);
+
+std::filesystem::path cache_path(int day, std::uint32_t version, std::uint64_t input_hash) {
+    std::array<char, 64> name{};
+    std::snprintf(name.data(), name.size(), "day%02d-v%u-%016llx.aocbin", day, version,
+                  static_cast<unsigned long long>(input_hash));
+    return std::filesystem::path(options().model_cache) / name.data();
+}
+
+class MappedCacheFile final : public CachedModel {
+public:
+    explicit MappedCacheFile(const std::filesystem::path &path) {
+#if defined(_WIN32)
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            return;
+        }
+        fallback_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        data_ = fallback_.data();
+        size_ = fallback_.size();
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+        struct stat st{};
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            void *addr = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED) {
+                data_ = static_cast<const char *>(addr);
+                size_ = static_cast<std::size_t>(st.st_size);
+            }
+        }
+        ::close(fd);
+#endif
+    }
+
+    MappedCacheFile(const MappedCacheFile &) = delete;
+    MappedCacheFile &operator=(const MappedCacheFile &) = delete;
+
+    ~MappedCacheFile() override {
+#if !defined(_WIN32)
+        if (data_) {
+            ::munmap(const_cast<char *>(data_), size_);
+        }
+#endif
+    }
+
+    [[nodiscard]] bool valid(int day, std::uint32_t version, std::uint64_t input_hash) const noexcept {
+        if (size_ < sizeof(Header)) {
+            return false;
+        }
+        Header header{};
+        std::memcpy(&header, data_, sizeof(Header));
+        return header.magic == magic && header.format == format_version &&
+               header.day == static_cast<std::uint32_t>(day) && header.version == version &&
+               header.input_hash == input_hash && header.payload_bytes == size_ - sizeof(Header);
+    }
+
+    [[nodiscard]] std::string_view payload() const noexcept override {
+        return {data_ + sizeof(Header), size_ - sizeof(Header)};
+    }
+
+private:
+    const char *data_{nullptr};
+    std::size_t size_{0};
+#if defined(_WIN32)
+    std::string fallback_;
+#endif
+};
+
+}  // namespace
+
+bool model_cache_enabled() noexcept {
+    return !options().model_cache.empty() && !options().no_cache;
+}
+
+std::uint64_t hash_lines(Lines lines) noexcept {
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for (const auto line : lines) {
+        for (const char ch : line) {
+            hash ^= static_cast<unsigned char>(ch);
+            hash *= 0x100000001b3ULL;
+        }
+        hash ^= static_cast<unsigned char>('\n');
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+std::unique_ptr<CachedModel> open_cached_model(int day, std::uint32_t version, std::uint64_t input_hash) {
+    auto file = std::make_unique<MappedCacheFile>(cache_path(day, version, input_hash));
+    if (!file->valid(day, version, input_hash)) {
+        return nullptr;
+    }
+    return file;
+}
+
+void write_file_atomically(const std::filesystem::path &path, std::string_view head, std::string_view body) {
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+
+    // Random per writer, so concurrent processes and threads never share it.
+    auto tmp = path;
+    tmp += ".tmp." + std::to_string(std::random_device{}()) + "." +
+           std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        out.write(head.data(), static_cast<std::streamsize>(head.size()));
+        out.write(body.data(), static_cast<std::streamsize>(body.size()));
+        if (!out) {
+            std::cerr << "warning: cannot write cache file " << tmp.string() << "\n";
+            std::filesystem::remove(tmp, ec);
+            return;
+        }
+    }
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+        std::cerr << "warning: cannot write cache file " << path.string() << ": " << ec.message() << "\n";
+        std::filesystem::remove(tmp, ec);
+    }
+}
+
+void store_cached_model(int day, std::uint32_t version, std::uint64_t input_hash, std::string_view payload) {
+    Header header{};
+    header.magic = magic;
+    header.format = format_version;
+    header.day = static_cast<std::uint32_t>(day);
+    header.version = version;
+    header.input_hash = input_hash;
+    header.payload_bytes = payload.size();
+    write_file_atomically(cache_path(day, version, input_hash),
+                          {reinterpret_cast<const char *>(&header), sizeof(Header)}, payload);
+}
+
+}  // namespace aoc
@@ -0,0 +1,201 @@
+#include "aoc/parallel.hpp"
+
+#include "aoc.hpp"
+
+#include <iostream>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace aoc {
+
+namespace {
+
+// Which pool (if any) the current thread works for, and its queue index.
+thread_local const ThreadPool *current_pool = nullptr;
+thread_local std::size_t current_index = 0;
+
+#if defined(__linux__)
+// CPUs this process may run on, in ascending order.
+std::vector<std::size_t> allowed_cpus() {
+    std::vector<std::size_t> cpus;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (std::size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+    return cpus;
+}
+#endif
+
+// Pin the calling thread to the slot-th allowed CPU (wrapping around).
+void pin_current_thread(std::size_t slot) {
+#if defined(__linux__)
+    static const std::vector<std::size_t> cpus = allowed_cpus();
+    if (cpus.empty()) {
+        return;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpus[slot % cpus.size()], &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        std::cerr << "warning: could not pin thread " << slot << " to a CPU\n";
+    }
+#else
+    static_cast<void>(slot);
+#endif
+}
+
+}  // namespace
+
+ThreadPool::ThreadPool(std::size_t threads, bool pin) {
+    const std::size_t workers = threads > 1 ? threads - 1 : 0;
+    for (std::size_t i = 0; i <= workers; ++i) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+    if (pin) {
+        // The constructing thread is the one that usually waits and helps.
+        pin_current_thread(0);
+    }
+    workers_.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) {
+        workers_.emplace_back([this, i, pin] { worker_loop(i, pin); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(sleep_mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    workers_.clear();
+}
+
+void ThreadPool::submit(Task task) {
+    const std::size_t index = current_pool == this ? current_index : queues_.size() - 1;
+    {
+        auto &queue = *queues_[index];
+        std::lock_guard lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    {
+        // Counted under the sleep mutex so a worker checking the predicate
+        // cannot miss the wake-up.
+        std::lock_guard lock(sleep_mutex_);
+        queued_.fetch_add(1, std::memory_order_relaxed);
+    }
+    wake_.notify_one();
+}
+
+std::optional<ThreadPool::Task> ThreadPool::pop_local(std::size_t index) {
+    auto &queue = *queues_[index];
+    std::lock_guard lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return std::nullopt;
+    }
+    // Workers take their newest task (still warm in cache); the inject
+    // queue is drained oldest first.
+    const bool inject = index == queues_.size() - 1;
+    Task task = inject ? std::move(queue.tasks.front()) : std::move(queue.tasks.back());
+    if (inject) {
+        queue.tasks.pop_front();
+    } else {
+        queue.tasks.pop_back();
+    }
+    return task;
+}
+
+std::optional<ThreadPool::Task> ThreadPool::steal(std::size_t thief) {
+    const std::size_t n = queues_.size();
+    for (std::size_t k = 1; k < n; ++k) {
+        auto &queue = *queues_[(thief + k) % n];
+        std::lock_guard lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            Task task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            return task;
+        }
+    }
+    return std::nullopt;
+}
+
+bool ThreadPool::run_one(std::size_t index) {
+    auto task = pop_local(index);
+    if (!task) {
+        task = steal(index);
+    }
+    if (!task) {
+        return false;
+    }
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+    (*task)();
+    return true;
+}
+
+bool ThreadPool::run_one() {
+    return run_one(current_pool == this ? current_index : queues_.size() - 1);
+}
+
+void ThreadPool::worker_loop(std::size_t index, bool pin) {
+    current_pool = this;
+    current_index = index;
+    if (pin) {
+        pin_current_thread(index + 1);
+    }
+
+    while (true) {
+        if (run_one(index)) {
+            continue;
+        }
+        std::unique_lock lock(sleep_mutex_);
+        wake_.wait(lock, [this] { return stop_ || queued_.load(std::memory_order_relaxed) > 0; });
+        if (stop_) {
+            return;
+        }
+    }
+}
+
+ThreadPool &thread_pool() {
+    static ThreadPool pool = [] {
+        const auto &opts = options();
+        const std::size_t threads =
+            opts.threads != 0 ? opts.threads : std::max(1u, std::thread::hardware_concurrency());
+        if (opts.perf && threads > 1) {
+            // perf_event counters are opened per thread (see PerfSession)
+            AOC_LOG(warn, "--perf counts only the thread that times each part; work on the other ", threads - 1,
+                    " pool threads is missing from the counters, use --threads=1 for complete numbers");
+        }
+        return ThreadPool(threads, opts.pin);
+    }();
+    return pool;
+}
+
+TaskGroup::~TaskGroup() {
+    // Tasks refer to this group; never let it go away under them.
+    while (pending_.load(std::memory_order_acquire) != 0) {
+        if (!pool_.run_one()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void TaskGroup::wait() {
+    while (pending_.load(std::memory_order_acquire) != 0) {
+        if (!pool_.run_one()) {
+            std::this_thread::yield();
+        }
+    }
+    std::lock_guard lock(error_mutex_);
+    if (error_) {
+        std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+}
+
+}  // namespace aoc
@@ -0,0 +1,188 @@
+#include "aoc/perf.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace aoc {
+
+namespace {
+
+constexpr std::size_t event_count = static_cast<std::size_t>(PerfEvent::count_);
+
+constexpr std::array<const char *, event_count> event_names{
+    "cycles", "instructions", "L1d misses", "LLC misses", "branch misses",
+};
+
+void warn_once(const std::string &reason) {
+    static std::once_flag flag;
+    std::call_once(flag, [&] {
+        std::cerr << "perf counters unavailable: " << reason << "\n";
+    });
+}
+
+#if defined(__linux__)
+
+struct EventSpec {
+    std::uint32_t type;
+    std::uint64_t config;
+};
+
+constexpr std::uint64_t cache_config(std::uint64_t cache) {
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+constexpr std::array<EventSpec, event_count> event_specs{{
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE, cache_config(PERF_COUNT_HW_CACHE_L1D)},
+    {PERF_TYPE_HW_CACHE, cache_config(PERF_COUNT_HW_CACHE_LL)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+}};
+
+int open_event(const EventSpec &spec) noexcept {
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = spec.type;
+    attr.config = spec.config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+#endif
+
+}  // namespace
+
+void PerfCounters::divide(std::size_t runs) noexcept {
+    if (runs <= 1) {
+        return;
+    }
+    for (auto &v : values) {
+        if (v) {
+            *v /= runs;
+        }
+    }
+}
+
+PerfSession &PerfSession::thread_local_instance() {
+    thread_local PerfSession session;
+    return session;
+}
+
+PerfSession::PerfSession() {
+    fds_.fill(-1);
+#if defined(__linux__)
+    int first_errno = 0;
+    for (std::size_t i = 0; i < event_count; ++i) {
+        fds_[i] = open_event(event_specs[i]);
+        if (fds_[i] >= 0) {
+            available_ = true;
+        } else if (first_errno == 0) {
+            first_errno = errno;
+        }
+    }
+    if (!available_) {
+        const bool denied = first_errno == EACCES || first_errno == EPERM;
+        warn_once(std::string("perf_event_open: ") + std::strerror(first_errno) +
+                  (denied ? " (check /proc/sys/kernel/perf_event_paranoid)" : ""));
+    }
+#else
+    warn_once("perf_event_open is Linux-only");
+#endif
+}
+
+PerfSession::~PerfSession() {
+#if defined(__linux__)
+    for (const int fd : fds_) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+#endif
+}
+
+void PerfSession::start() noexcept {
+#if defined(__linux__)
+    for (const int fd : fds_) {
+        if (fd >= 0) {
+            ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#endif
+}
+
+std::optional<PerfCounters> PerfSession::stop() noexcept {
+    if (!available_) {
+        return std::nullopt;
+    }
+    PerfCounters counters;
+#if defined(__linux__)
+    for (const int fd : fds_) {
+        if (fd >= 0) {
+            ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+    for (std::size_t i = 0; i < event_count; ++i) {
+        if (fds_[i] < 0) {
+            continue;
+        }
+        // value, time_enabled, time_running
+        std::uint64_t data[3]{};
+        if (::read(fds_[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || data[2] == 0) {
+            continue;
+        }
+        // Scale up when the kernel had to multiplex the counter.
+        const double scale = static_cast<double>(data[1]) / static_cast<double>(data[2]);
+        counters.values[i] = static_cast<std::uint64_t>(static_cast<double>(data[0]) * scale);
+    }
+#endif
+    return counters;
+}
+
+void print_perf(const PerfCounters &counters, std::size_t input_bytes) {
+    const auto flags = std::cout.flags();
+    const auto precision = std::cout.precision();
+
+    std::cout << "  perf:";
+    const auto cycles = counters[PerfEvent::cycles];
+    const auto instructions = counters[PerfEvent::instructions];
+    if (cycles && instructions && *cycles > 0) {
+        std::cout << std::fixed << std::setprecision(2) << " IPC "
+                  << static_cast<double>(*instructions) / static_cast<double>(*cycles) << ",";
+    }
+    for (std::size_t i = 0; i < event_count; ++i) {
+        std::cout << " " << event_names[i] << " ";
+        if (!counters.values[i]) {
+            std::cout << "n/a";
+        } else {
+            std::cout << *counters.values[i];
+            const auto e = static_cast<PerfEvent>(i);
+            const bool is_miss = e == PerfEvent::l1d_misses || e == PerfEvent::llc_misses ||
+                                 e == PerfEvent::branch_misses;
+            if (is_miss && input_bytes > 0) {
+                std::cout << std::fixed << std::setprecision(4) << " ("
+                          << static_cast<double>(*counters.values[i]) / static_cast<double>(input_bytes)
+                          << "/B)";
+            }
+        }
+        std::cout << (i + 1 < event_count ? "," : "\n");
+    }
+
+    std::cout.flags(flags);
+    std::cout.precision(precision);
+}
+
+}  // namespace aoc
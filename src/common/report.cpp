@@ -0,0 +1,207 @@
+#include "aoc/report.hpp"
+
+#include <array>
+#include <cstdio>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <vector>
+
+namespace aoc {
+
+namespace {
+
+constexpr std::array<std::string_view, 21> columns{
+    "day",          "stage",        "answer",     "micros",      "runs",
+    "min_ns",       "median_ns",    "mean_ns",    "p99_ns",      "stddev_ns",
+    "cycles",       "instructions", "l1d_misses", "llc_misses",  "branch_misses",
+    "allocations",  "alloc_bytes",  "peak_bytes", "input_bytes", "input_hash",
+    "input",
+};
+
+// Columns written as JSON strings; the rest are numbers.
+bool is_text_column(std::size_t column) {
+    const auto name = columns[column];
+    return name == "stage" || name == "answer" || name == "input_hash" || name == "input";
+}
+
+using Row = std::array<std::optional<std::string>, columns.size()>;
+
+template <typename T>
+std::optional<std::string> num(const std::optional<T> &value) {
+    if (!value) {
+        return std::nullopt;
+    }
+    std::ostringstream os;
+    if constexpr (std::is_floating_point_v<T>) {
+        os.setf(std::ios::fixed);
+        os.precision(1);
+    }
+    os << *value;
+    return os.str();
+}
+
+template <typename T>
+std::optional<std::string> num(const T &value) {
+    return num(std::optional<T>{value});
+}
+
+std::string hex64(std::uint64_t value) {
+    std::array<char, 17> buf{};
+    std::snprintf(buf.data(), buf.size(), "%016llx", static_cast<unsigned long long>(value));
+    return buf.data();
+}
+
+Row make_row(const DayReport &report, std::string_view stage, const std::optional<std::string> &answer,
+             const Timing &timing) {
+    Row row;
+    std::size_t c = 0;
+    row[c++] = num(report.day);
+    row[c++] = std::string(stage);
+    row[c++] = answer;
+    row[c++] = num(timing.micros);
+
+    const auto &bench = timing.bench;
+    row[c++] = bench ? num(bench->runs) : num(std::size_t{1});
+    row[c++] = bench ? num(bench->min_ns) : std::nullopt;
+    row[c++] = bench ? num(bench->median_ns) : std::nullopt;
+    row[c++] = bench ? num(bench->mean_ns) : std::nullopt;
+    row[c++] = bench ? num(bench->p99_ns) : std::nullopt;
+    row[c++] = bench ? num(bench->stddev_ns) : std::nullopt;
+
+    for (std::size_t e = 0; e < static_cast<std::size_t>(PerfEvent::count_); ++e) {
+        row[c++] = timing.perf ? num(timing.perf->values[e]) : std::nullopt;
+    }
+
+    const auto &alloc = timing.alloc;
+    row[c++] = alloc ? num(alloc->allocations) : std::nullopt;
+    row[c++] = alloc ? num(alloc->bytes) : std::nullopt;
+    row[c++] = alloc ? num(alloc->peak_bytes) : std::nullopt;
+
+    row[c++] = num(report.input_bytes);
+    row[c++] = hex64(report.input_hash);
+    row[c++] = report.input;
+    return row;
+}
+
+std::vector<Row> make_rows(std::span<const DayReport> reports) {
+    std::vector<Row> rows;
+    for (const auto &report : reports) {
+        rows.push_back(make_row(report, "parse", std::nullopt, report.result.parse));
+        for (const auto &p : report.result.parts) {
+            rows.push_back(make_row(report, "part" + std::to_string(p.part), p.answer, p.timing));
+        }
+    }
+    return rows;
+}
+
+void write_json_string(std::ostream &os, std::string_view s) {
+    os << '"';
+    for (const char ch : s) {
+        switch (ch) {
+            case '"': os << "\\\""; break;
+            case '\\': os << "\\\\"; break;
+            case '\n': os << "\\n"; break;
+            case '\t': os << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(ch) < 0x20) {
+                    std::array<char, 7> buf{};
+                    std::snprintf(buf.data(), buf.size(), "\\u%04x", static_cast<unsigned>(ch));
+                    os << buf.data();
+                } else {
+                    os << ch;
+                }
+        }
+    }
+    os << '"';
+}
+
+void write_json(std::ostream &os, const std::vector<Row> &rows) {
+    os << "[\n";
+    for (std::size_t r = 0; r < rows.size(); ++r) {
+        os << "  {";
+        for (std::size_t c = 0; c < columns.size(); ++c) {
+            os << (c == 0 ? "" : ", ") << '"' << columns[c] << "\": ";
+            const auto &cell = rows[r][c];
+            if (!cell) {
+                os << "null";
+            } else if (is_text_column(c)) {
+                write_json_string(os, *cell);
+            } else {
+                os << *cell;
+            }
+        }
+        os << (r + 1 < rows.size() ? "},\n" : "}\n");
+    }
+    os << "]\n";
+}
+
+void write_csv_cell(std::ostream &os, std::string_view s) {
+    if (s.find_first_of(",\"\n") == std::string_view::npos) {
+        os << s;
+        return;
+    }
+    os << '"';
+    for (const char ch : s) {
+        os << (ch == '"' ? "\"\"" : std::string_view{&ch, 1});
+    }
+    os << '"';
+}
+
+void write_csv(std::ostream &os, const std::vector<Row> &rows) {
+    for (std::size_t c = 0; c < columns.size(); ++c) {
+        os << (c == 0 ? "" : ",") << columns[c];
+    }
+    os << "\n";
+    for (const auto &row : rows) {
+        for (std::size_t c = 0; c < columns.size(); ++c) {
+            if (c != 0) {
+                os << ',';
+            }
+            if (row[c]) {
+                write_csv_cell(os, *row[c]);
+            }
+        }
+        os << "\n";
+    }
+}
+
+}  // namespace
+
+std::uint64_t hash_input(std::string_view bytes) noexcept {
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for (const char ch : bytes) {
+        hash ^= static_cast<unsigned char>(ch);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+std::span<const std::string_view> report_columns() {
+    return columns;
+}
+
+void write_report(std::ostream &os, OutputFormat format, std::span<const DayReport> reports) {
+    const auto rows = make_rows(reports);
+    switch (format) {
+        case OutputFormat::json:
+            write_json(os, rows);
+            break;
+        case OutputFormat::csv:
+            write_csv(os, rows);
+            break;
+        case OutputFormat::text:
+            throw std::runtime_error("write_report needs json or csv");
+    }
+}
+
+StdoutToStderr::StdoutToStderr() : saved_(std::cout.rdbuf()), out_(saved_) {
+    std::cout.flush();
+    std::cout.rdbuf(std::cerr.rdbuf());
+}
+
+StdoutToStderr::~StdoutToStderr() {
+    std::cout.rdbuf(saved_);
+}
+
+}  // namespace aoc
@@ -0,0 +1,186 @@
+#include "aoc/scan.hpp"
+
+#include <bit>
+#include <concepts>
+#include <limits>
+#include <stdexcept>
+
+#if defined(AOC_DISPATCH_X86)
+#include <immintrin.h>
+#endif
+
+namespace aoc {
+
+namespace {
+
+// Push the offsets of the set bits in `bits`, relative to `base`.
+template <std::unsigned_integral Bits>
+inline void emit(std::vector<std::uint32_t> &dst, std::uint32_t base, Bits bits) {
+    while (bits != 0) {
+        dst.push_back(base + static_cast<std::uint32_t>(std::countr_zero(bits)));
+        bits &= bits - 1;
+    }
+}
+
+[[nodiscard]]
+constexpr bool matches(char c, DelimSet set) noexcept {
+    switch (c) {
+    case '\n': return (set & newline) != 0;
+    case ',':  return (set & comma) != 0;
+    case ' ':  return (set & space) != 0;
+    case '-':  return (set & dash) != 0;
+    case ':':  return (set & colon) != 0;
+    default:   return false;
+    }
+}
+
+void scan_scalar(std::string_view text, std::size_t from, DelimSet set, DelimiterOffsets &out) {
+    for (std::size_t i = from; i < text.size(); ++i) {
+        const char c = text[i];
+        if (c == '\n') {
+            out.lines.push_back(static_cast<std::uint32_t>(i));
+        }
+        if (matches(c, set)) {
+            out.fields.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+}
+
+void scan_scalar_all(std::string_view text, DelimSet set, DelimiterOffsets &out) {
+    scan_scalar(text, 0, set, out);
+}
+
+#if defined(AOC_DISPATCH_X86)
+
+void scan_sse2(std::string_view text, DelimSet set, DelimiterOffsets &out) {
+    const auto nl    = _mm_set1_epi8('\n');
+    const auto cm    = _mm_set1_epi8(',');
+    const auto sp    = _mm_set1_epi8(' ');
+    const auto ds    = _mm_set1_epi8('-');
+    const auto cl    = _mm_set1_epi8(':');
+    const auto zero  = _mm_setzero_si128();
+    const auto all   = _mm_set1_epi8(-1);
+    // Disabled classes compare against a mask of zero and never contribute.
+    const auto en_nl = (set & newline) ? all : zero;
+    const auto en_cm = (set & comma) ? all : zero;
+    const auto en_sp = (set & space) ? all : zero;
+    const auto en_ds = (set & dash) ? all : zero;
+    const auto en_cl = (set & colon) ? all : zero;
+
+    const char *p = text.data();
+    std::size_t i = 0;
+    for (; i + 16 <= text.size(); i += 16) {
+        const auto v   = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+        const auto eq_nl = _mm_cmpeq_epi8(v, nl);
+        auto hit = _mm_and_si128(eq_nl, en_nl);
+        hit = _mm_or_si128(hit, _mm_and_si128(_mm_cmpeq_epi8(v, cm), en_cm));
+        hit = _mm_or_si128(hit, _mm_and_si128(_mm_cmpeq_epi8(v, sp), en_sp));
+        hit = _mm_or_si128(hit, _mm_and_si128(_mm_cmpeq_epi8(v, ds), en_ds));
+        hit = _mm_or_si128(hit, _mm_and_si128(_mm_cmpeq_epi8(v, cl), en_cl));
+
+        const auto base = static_cast<std::uint32_t>(i);
+        emit(out.lines, base, static_cast<std::uint32_t>(_mm_movemask_epi8(eq_nl)));
+        emit(out.fields, base, static_cast<std::uint32_t>(_mm_movemask_epi8(hit)));
+    }
+    scan_scalar(text, i, set, out);
+}
+
+AOC_TARGET_AVX2
+void scan_avx2(std::string_view text, DelimSet set, DelimiterOffsets &out) {
+    const auto nl    = _mm256_set1_epi8('\n');
+    const auto cm    = _mm256_set1_epi8(',');
+    const auto sp    = _mm256_set1_epi8(' ');
+    const auto ds    = _mm256_set1_epi8('-');
+    const auto cl    = _mm256_set1_epi8(':');
+    const auto zero  = _mm256_setzero_si256();
+    const auto all   = _mm256_set1_epi8(-1);
+    const auto en_nl = (set & newline) ? all : zero;
+    const auto en_cm = (set & comma) ? all : zero;
+    const auto en_sp = (set & space) ? all : zero;
+    const auto en_ds = (set & dash) ? all : zero;
+    const auto en_cl = (set & colon) ? all : zero;
+
+    const char *p = text.data();
+    std::size_t i = 0;
+    for (; i + 32 <= text.size(); i += 32) {
+        const auto v     = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+        const auto eq_nl = _mm256_cmpeq_epi8(v, nl);
+        auto hit = _mm256_and_si256(eq_nl, en_nl);
+        hit = _mm256_or_si256(hit, _mm256_and_si256(_mm256_cmpeq_epi8(v, cm), en_cm));
+        hit = _mm256_or_si256(hit, _mm256_and_si256(_mm256_cmpeq_epi8(v, sp), en_sp));
+        hit = _mm256_or_si256(hit, _mm256_and_si256(_mm256_cmpeq_epi8(v, ds), en_ds));
+        hit = _mm256_or_si256(hit, _mm256_and_si256(_mm256_cmpeq_epi8(v, cl), en_cl));
+
+        const auto base = static_cast<std::uint32_t>(i);
+        emit(out.lines, base, static_cast<std::uint32_t>(_mm256_movemask_epi8(eq_nl)));
+        emit(out.fields, base, static_cast<std::uint32_t>(_mm256_movemask_epi8(hit)));
+    }
+    scan_scalar(text, i, set, out);
+}
+
+// AVX-512BW compares straight into 64-bit masks; a disabled class simply
+// leaves its compare out of the mask.
+AOC_TARGET_AVX512
+void scan_avx512(std::string_view text, DelimSet set, DelimiterOffsets &out) {
+    const auto nl = _mm512_set1_epi8('\n');
+    const auto cm = _mm512_set1_epi8(',');
+    const auto sp = _mm512_set1_epi8(' ');
+    const auto ds = _mm512_set1_epi8('-');
+    const auto cl = _mm512_set1_epi8(':');
+    const __mmask64 en_nl = (set & newline) ? ~__mmask64{0} : 0;
+    const __mmask64 en_cm = (set & comma) ? ~__mmask64{0} : 0;
+    const __mmask64 en_sp = (set & space) ? ~__mmask64{0} : 0;
+    const __mmask64 en_ds = (set & dash) ? ~__mmask64{0} : 0;
+    const __mmask64 en_cl = (set & colon) ? ~__mmask64{0} : 0;
+
+    const char *p = text.data();
+    std::size_t i = 0;
+    for (; i + 64 <= text.size(); i += 64) {
+        const auto v = _mm512_loadu_si512(p + i);
+        const __mmask64 eq_nl = _mm512_cmpeq_epi8_mask(v, nl);
+        const __mmask64 hit = (eq_nl & en_nl) | (_mm512_cmpeq_epi8_mask(v, cm) & en_cm) |
+                              (_mm512_cmpeq_epi8_mask(v, sp) & en_sp) | (_mm512_cmpeq_epi8_mask(v, ds) & en_ds) |
+                              (_mm512_cmpeq_epi8_mask(v, cl) & en_cl);
+
+        const auto base = static_cast<std::uint32_t>(i);
+        emit(out.lines, base, static_cast<std::uint64_t>(eq_nl));
+        emit(out.fields, base, static_cast<std::uint64_t>(hit));
+    }
+    scan_scalar(text, i, set, out);
+}
+
+#endif
+
+constexpr KernelVersion<ScanKernel> versions[] = {
+    {Isa::scalar, scan_scalar_all},
+#if defined(AOC_DISPATCH_X86)
+    {Isa::sse2, scan_sse2},
+    {Isa::avx2, scan_avx2},
+    {Isa::avx512, scan_avx512},
+#endif
+};
+
+const KernelVersion<ScanKernel> &impl() noexcept {
+    static const auto chosen = select_kernel(versions);
+    return chosen;
+}
+
+}  // namespace
+
+void scan_delimiters(std::string_view text, DelimSet set, DelimiterOffsets &out) {
+    if (text.size() > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::runtime_error("scan_delimiters: buffer larger than 4 GiB");
+    }
+    out.clear();
+    impl().fn(text, set, out);
+}
+
+const char *scan_isa() noexcept {
+    return isa_name(impl().isa);
+}
+
+std::span<const KernelVersion<ScanKernel>> scan_versions() noexcept {
+    return versions;
+}
+
+}  // namespace aoc
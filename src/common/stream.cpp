@@ -0,0 +1,107 @@
+#include "aoc/stream.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace aoc {
+
+namespace {
+
+#if defined(_WIN32)
+int open_file(const std::filesystem::path &path) { return ::_wopen(path.c_str(), _O_RDONLY | _O_BINARY); }
+long read_some(int fd, char *data, std::size_t size) { return ::_read(fd, data, static_cast<unsigned>(size)); }
+void close_file(int fd) { ::_close(fd); }
+#else
+int open_file(const std::filesystem::path &path) { return ::open(path.c_str(), O_RDONLY); }
+long read_some(int fd, char *data, std::size_t size) { return ::read(fd, data, size); }
+void close_file(int fd) { ::close(fd); }
+#endif
+
+}  // namespace
+
+LineReader::LineReader(const std::filesystem::path &path, std::size_t buffer_size) : buffer_(buffer_size) {
+    if (path == "-") {
+        fd_ = 0;
+        return;
+    }
+    fd_ = open_file(path);
+    if (fd_ < 0) {
+        throw std::runtime_error("Failed to open input stream: " + path.string());
+    }
+    owned_ = true;
+}
+
+LineReader::~LineReader() {
+    if (owned_) {
+        close_file(fd_);
+    }
+}
+
+bool LineReader::next(std::string_view &line) {
+    std::size_t searched = begin_;
+    while (true) {
+        const auto *nl = static_cast<const char *>(std::memchr(buffer_.data() + searched, '\n', end_ - searched));
+        if (nl != nullptr) {
+            const auto at = static_cast<std::size_t>(nl - buffer_.data());
+            line = {buffer_.data() + begin_, at - begin_};
+            begin_ = at + 1;
+            break;
+        }
+        searched = end_ - begin_;  // the tail moves to the front and was already searched
+        if (!refill()) {
+            if (begin_ == end_) {
+                return false;
+            }
+            line = {buffer_.data() + begin_, end_ - begin_};
+            begin_ = end_;
+            break;
+        }
+    }
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+    ++lines_;
+    return true;
+}
+
+bool LineReader::refill() {
+    if (eof_) {
+        return false;
+    }
+    const std::size_t tail = end_ - begin_;
+    if (begin_ != 0) {
+        std::memmove(buffer_.data(), buffer_.data() + begin_, tail);
+        begin_ = 0;
+        end_ = tail;
+    }
+    if (end_ == buffer_.size()) {
+        throw std::runtime_error("input stream: line longer than " + std::to_string(buffer_.size()) + " bytes");
+    }
+    while (true) {
+        const long n = read_some(fd_, buffer_.data() + end_, buffer_.size() - end_);
+        if (n > 0) {
+            end_ += static_cast<std::size_t>(n);
+            bytes_ += static_cast<std::uint64_t>(n);
+            return true;
+        }
+        if (n == 0) {
+            eof_ = true;
+            return false;
+        }
+        if (errno != EINTR) {
+            throw std::runtime_error(std::string("input stream: read failed: ") + std::strerror(errno));
+        }
+    }
+}
+
+}  // namespace aoc
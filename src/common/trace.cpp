@@ -0,0 +1,100 @@
+// Per-thread trace buffers and the Chrome trace-event JSON writer behind
+// AOC_ZONE. Only compiled into aoc_common when AOC_TRACE is ON.
+#include "aoc.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace aoc::trace {
+
+namespace {
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+};
+
+Registry &registry() {
+    static Registry reg;
+    return reg;
+}
+
+void write_escaped(std::ostream &out, const char *s) {
+    for (; *s != '\0'; ++s) {
+        if (*s == '"' || *s == '\\') {
+            out << '\\';
+        }
+        out << *s;
+    }
+}
+
+void dump_at_exit() {
+    auto &reg = registry();
+    std::lock_guard lock(reg.mutex);
+
+    const auto &path = options().trace_path;
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "trace: cannot write " << path << "\n";
+        return;
+    }
+
+    // Timestamps are made relative to the earliest recorded zone.
+    auto retained = [](const ThreadBuffer &buf) {
+        const auto written = buf.written.load(std::memory_order_acquire);
+        return std::pair{written > ThreadBuffer::capacity ? written - ThreadBuffer::capacity : 0, written};
+    };
+    std::int64_t origin_ns = std::numeric_limits<std::int64_t>::max();
+    for (const auto &buf : reg.buffers) {
+        const auto [from, written] = retained(*buf);
+        for (auto i = from; i < written; ++i) {
+            origin_ns = std::min(origin_ns, buf->events[i & (ThreadBuffer::capacity - 1)].begin_ns);
+        }
+    }
+
+    // trace-event timestamps are microseconds; three fixed decimals keep ns
+    // precision however far an event is from the origin
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    bool first = true;
+    std::size_t count = 0;
+    for (const auto &buf : reg.buffers) {
+        const auto [from, written] = retained(*buf);
+        for (auto i = from; i < written; ++i) {
+            const auto &e = buf->events[i & (ThreadBuffer::capacity - 1)];
+            out << (first ? "\n" : ",\n") << "{\"name\":\"";
+            write_escaped(out, e.name);
+            out << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buf->tid
+                << ",\"ts\":" << static_cast<double>(e.begin_ns - origin_ns) / 1000.0
+                << ",\"dur\":" << static_cast<double>(e.end_ns - e.begin_ns) / 1000.0 << "}";
+            first = false;
+            ++count;
+        }
+    }
+    out << "\n]}\n";
+    std::cerr << "trace: wrote " << count << " events to " << path << "\n";
+}
+
+}  // namespace
+
+ThreadBuffer &thread_buffer() {
+    thread_local ThreadBuffer *mine = [] {
+        auto &reg = registry();
+        std::lock_guard lock(reg.mutex);
+        if (reg.buffers.empty()) {
+            std::atexit(dump_at_exit);
+        }
+        auto &buf = reg.buffers.emplace_back(std::make_unique<ThreadBuffer>());
+        buf->tid = static_cast<std::uint32_t>(reg.buffers.size() - 1);
+        return buf.get();
+    }();
+    return *mine;
+}
+
+}  // namespace aoc::trace
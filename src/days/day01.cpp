@@ -1,115 +1,187 @@
-#include "aoc.hpp"
+#include "day01.hpp"
 
-#include <cassert>
+#include "aoc/day.hpp"
+#include "aoc/dispatch.hpp"
+#include "aoc/parallel.hpp"
+
+#include <array>
 #include <cstdlib>   // std::exit
 #include <iostream>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 using namespace aoc;
 
-namespace {
-    std::string day_input_path(int argc, char **argv) {
-        if (argc > 1) {
-            return argv[1];  // allow custom path
-        }
-        return "input/day01.txt";
+namespace day01 {
+
+std::int32_t parse_rotation(std::string_view line) {
+    if (line.empty() || (line[0] != 'L' && line[0] != 'R')) {
+        throw std::runtime_error("Invalid rotation: " + std::string(line));
     }
+    const auto value = parse<std::int32_t>(line.substr(1));  // from pos 1 to end
+    return line[0] == 'R' ? value : -value;
 }
 
-int get_new_dial_pos(int current_pos, char turn, int delta) {
-    delta = delta % 100; // wrap around full circle
-    if (turn == 'L') { // turn left
-        if (current_pos - delta < 0) {
-            current_pos = 100 + (current_pos - delta);
-        } else {
-            current_pos = current_pos - delta;
-        }
-    } else if (turn == 'R') {  // turn right
-        if (current_pos + delta >= 100) {
-            current_pos = (current_pos + delta) - 100;
-        } else {
-            current_pos = current_pos + delta;
-        }
-    } else {
-        throw std::runtime_error("Invalid turn character: " + std::string(1, turn));
+Deltas parse_deltas(Lines lines) {
+    Deltas deltas;
+    deltas.reserve(lines.size());
+    for (const auto &line : lines) {
+        deltas.push_back(parse_rotation(line));
     }
-    return current_pos;
+    return deltas;
 }
 
-int solve_part1(const std::vector<std::string> &lines) {
-    int count_zero{0};
-    // Dial pos starts at 50
-    int dial_pos{50};
+// Zero stops and zero clicks of one block, given the position before each
+// rotation. Every rotation is independent here, so the loop vectorizes.
+//
+// Part 2 counts a rotation of v clicks from p as:
+//   v / 100 full turns when v > 100, then, for the remaining r clicks
+//   (v itself when v <= 100), one more when n = p +- r lands on 0 or a
+//   multiple of 100, passes 100, or goes below 0 from a non-zero start.
+struct BlockCount {
+    long long stops;
+    long long clicks;
+};
+
+[[gnu::always_inline]] inline BlockCount count_block_body(const std::int32_t *deltas, const std::int32_t *before,
+                                                          std::size_t n) {
+    int stops = 0;
+    int hits = 0;
+    long long turns = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const int d = deltas[i];
+        const int p = before[i];
+        const int v = d < 0 ? -d : d;
+        const int q = v > 100 ? v / 100 : 0;
+        const int r = v - q * 100;
+        const int e = p + (d < 0 ? -r : r);  // in [-100, 199]
+        stops += static_cast<int>((e == 0) | (e == 100) | (e == -100));
+        hits += static_cast<int>((e == 0) | (e >= 100) | (e <= -100) | ((p != 0) & (e < 0)));
+        turns += q;
+    }
+    return {stops, turns + hits};
+}
 
-    for (const auto &line : lines) {
-        char turn = line[0];                   // 'L' or 'R'
-        int value = std::stoi(line.substr(1)); // from pos 1 to end
-        dial_pos = get_new_dial_pos(dial_pos, turn, value);
-        if (dial_pos == 0) {
-            count_zero++;
+AOC_KERNEL_VERSIONS(count_block, BlockCount, (const std::int32_t *deltas, const std::int32_t *before, std::size_t n),
+                    (deltas, before, n))
+
+// Each delta reduced to a forward step in [0, 100), so the positions are a
+// running sum with a single conditional subtract per rotation.
+[[gnu::always_inline]] inline void forward_steps_body(const std::int32_t *deltas, std::int32_t *steps,
+                                                      std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        const int m = deltas[i] % dial_size;
+        steps[i] = m < 0 ? m + dial_size : m;
+    }
+}
+
+AOC_KERNEL_VERSIONS(forward_steps, void, (const std::int32_t *deltas, std::int32_t *steps, std::size_t n),
+                    (deltas, steps, n))
+
+DialRun run_dial(std::span<const std::int32_t> deltas, int start) {
+    static const auto count_block = select_kernel(count_block_versions).fn;
+    static const auto forward_steps = select_kernel(forward_steps_versions).fn;
+
+    // Blocks keep the position buffer in L1 between the three passes.
+    constexpr std::size_t block = 2048;
+    std::array<std::int32_t, block> steps;
+    std::array<std::int32_t, block> before;
+
+    DialRun run{.end = start};
+    for (std::size_t first = 0; first < deltas.size(); first += block) {
+        const std::size_t n = std::min(block, deltas.size() - first);
+        forward_steps(deltas.data() + first, steps.data(), n);
+        int p = run.end;
+        for (std::size_t i = 0; i < n; ++i) {
+            before[i] = p;
+            p += steps[i];
+            p -= p >= dial_size ? dial_size : 0;
         }
-        // std::cout << "turn = " << turn << ", value = " << value << ", new_pos = " << dial_pos << "\n";
+        run.end = p;
+        const auto counted = count_block(deltas.data() + first, before.data(), n);
+        run.stops += counted.stops;
+        run.clicks += counted.clicks;
     }
-    return count_zero;
+    return run;
 }
 
-int solve_part2(const std::vector<std::string> &lines) {
-    int count_zero{0};
-    // Dial pos starts at 50
-    int dial_pos{50};
+[[gnu::always_inline]] inline long long shift_sum_body(const std::int32_t *deltas, std::size_t n) {
+    long long sum = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const int m = deltas[i] % dial_size;
+        sum += m < 0 ? m + dial_size : m;
+    }
+    return sum;
+}
 
-    for (const auto &line : lines) {
-        char turn = line[0];                   // 'L' or 'R'
-        int value = std::stoi(line.substr(1)); // from pos 1 to end
-
-        int factor = turn == 'R' ? 1 : -1;
-        // std::cout << "count_zero = " << count_zero << ", turn = " << turn << ", value = " << value << ", dial_pos = " << dial_pos;
-        if (value > 100) {
-            count_zero += value / 100;
-            value = value % 100;
-        }
+AOC_KERNEL_VERSIONS(shift_sum, long long, (const std::int32_t *deltas, std::size_t n), (deltas, n))
 
-        int new_dial_pos = dial_pos + factor * value;
-        // std::cout << ", new_dial_pos = " << new_dial_pos << " " << abs(new_dial_pos) % 100 << std::endl;
-        if (abs(new_dial_pos) % 100 == 0 ||
-            new_dial_pos > 100 ||
-            // Avoid double counting when starting from zero and going negative
-            (dial_pos != 0 && new_dial_pos < 0)) {
-            // We will cross zero
-            ++count_zero;
-            // std::cout << "  -> crossed zero! count_zero = " << count_zero << std::endl;
-        }
+int dial_shift(std::span<const std::int32_t> deltas) {
+    static const auto shift_sum = select_kernel(shift_sum_versions).fn;
+    return static_cast<int>(shift_sum(deltas.data(), deltas.size()) % dial_size);
+}
 
-        if (new_dial_pos < 0) {
-            new_dial_pos += 100;
-        }
+DialRun run_dial_parallel(std::span<const std::int32_t> deltas, int start, std::size_t min_chunk) {
+    const std::size_t threads = thread_pool().size();
+    if (threads == 1 || deltas.size() < 2 * min_chunk) {
+        return run_dial(deltas, start);
+    }
+    // A few chunks per thread, so stealing evens out slow cores
+    const std::size_t chunk = std::max(min_chunk, (deltas.size() + 4 * threads - 1) / (4 * threads));
+    const std::size_t chunks = (deltas.size() + chunk - 1) / chunk;
+    const auto piece = [&](std::size_t i) {
+        return deltas.subspan(i * chunk, std::min(chunk, deltas.size() - i * chunk));
+    };
+
+    std::vector<int> starts(chunks);
+    parallel_for(0, chunks, [&](std::size_t i) { starts[i] = dial_shift(piece(i)); }, 1);
+    // exclusive prefix of the shifts: where each chunk starts
+    int position = start;
+    for (auto &s : starts) {
+        const int shift = s;
+        s = position;
+        position = (position + shift) % dial_size;
+    }
 
-        assert(new_dial_pos >= 0 && new_dial_pos < 200);
-        dial_pos = new_dial_pos % 100;
-        // Assert that dial_pos is within bounds
-        assert(dial_pos >= 0 && dial_pos < 100);
+    std::vector<DialRun> runs(chunks);
+    parallel_for(0, chunks, [&](std::size_t i) { runs[i] = run_dial(piece(i), starts[i]); }, 1);
+    DialRun total{.end = position};
+    for (const auto &run : runs) {
+        total.stops += run.stops;
+        total.clicks += run.clicks;
     }
-    return count_zero;
+    return total;
+}
+
+void DialStream::flush() {
+    const auto counted = run_dial({pending_.data(), size_}, run_.end);
+    run_.end = counted.end;
+    run_.stops += counted.stops;
+    run_.clicks += counted.clicks;
+    size_ = 0;
 }
 
-int main(int argc, char **argv) {
-    try {
-        const auto input_path = day_input_path(argc, argv);
-        auto lines = read_lines(input_path);
+long long solve_part1(const Deltas &deltas) {
+    // Dial pos starts at 50
+    return run_dial_parallel(deltas).stops;
+}
 
-        {
-            auto [ans1, t1] = time_it([&] { return solve_part1(lines); });
-            print_answer(1, ans1, t1);
-        }
+long long solve_part2(const Deltas &deltas) {
+    return run_dial_parallel(deltas).clicks;
+}
 
-        {
-            auto [ans2, t2] = time_it([&] { return solve_part2(lines); });
-            print_answer(2, ans2, t2);
-        }
+struct Day01 {
+    using Model = Deltas;
+    using Stream = DialStream;
+    static Model parse(Lines lines) { return parse_deltas(lines); }
+    static constexpr std::uint32_t model_version = 2;  // 2: signed deltas instead of (turn, value)
+    static void save(const Model &deltas, BinaryWriter &out) { out.put(deltas); }
+    static Model load(BinaryReader &in) { return in.get_vector<std::int32_t>(); }
+    static long long part1(const Model &deltas) { return solve_part1(deltas); }
+    static long long part2(const Model &deltas) { return solve_part2(deltas); }
+};
 
-    } catch (const std::exception &e) {
-        std::cerr << "Error: " << e.what() << "\n";
-        return EXIT_FAILURE;
-    }
-    return EXIT_SUCCESS;
-}
\ No newline at end of file
+}  // namespace day01
+
+AOC_REGISTER_DAY(1, day01::Day01, "input/day01.txt")
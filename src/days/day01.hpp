@@ -0,0 +1,76 @@
+#pragma once
+
+#include "aoc.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// Day 1 kernels, shared with aoc_bench.
+namespace day01 {
+
+// One signed click count per rotation: "R42" is +42, "L42" is -42.
+using Deltas = std::vector<std::int32_t>;
+
+std::int32_t parse_rotation(std::string_view line);
+Deltas parse_deltas(aoc::Lines lines);
+
+inline constexpr int dial_size = 100;
+inline constexpr int dial_start = 50;
+
+// What a run of rotations does to the dial from a given start position.
+struct DialRun {
+    int end{0};             // final position
+    long long stops{0};     // rotations that end on 0 (part 1)
+    long long clicks{0};    // times the dial points at 0, as part 2 counts them
+};
+
+DialRun run_dial(std::span<const std::int32_t> deltas, int start = dial_start);
+
+// A run of rotations moves every start position by the same amount, so the
+// position half of its effect is just this shift: end = (start + shift) % 100.
+// Shifts of consecutive runs add, which is what lets run_dial_parallel find
+// where every chunk starts before counting any of them.
+int dial_shift(std::span<const std::int32_t> deltas);
+
+// run_dial split into chunks of at least `min_chunk` rotations on the thread
+// pool: the chunk shifts are computed in parallel and prefix-summed into
+// start positions, then every chunk is counted from its own start. Shorter
+// logs run sequentially.
+DialRun run_dial_parallel(std::span<const std::int32_t> deltas, int start = dial_start,
+                          std::size_t min_chunk = std::size_t{1} << 16);
+
+// Day 1 over a stream of rotations in constant memory: lines are parsed
+// into a fixed block and counted with run_dial whenever it fills up or an
+// answer is asked for, carrying only the dial position and the two counts.
+class DialStream {
+public:
+    void feed(std::string_view line) {
+        pending_[size_++] = parse_rotation(line);
+        if (size_ == pending_.size()) {
+            flush();
+        }
+    }
+
+    long long part1() {
+        flush();
+        return run_.stops;
+    }
+
+    long long part2() {
+        flush();
+        return run_.clicks;
+    }
+
+private:
+    void flush();
+
+    std::array<std::int32_t, 4096> pending_{};
+    std::size_t size_{0};
+    DialRun run_{.end = dial_start};
+};
+
+}  // namespace day01
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "aoc/dispatch.hpp"
+
+#include <cstdint>
+
+// Day 2 kernels, shared with aoc_bench.
+namespace day02 {
+
+struct Range {
+    std::uint64_t start;
+    std::uint64_t end;
+};
+
+// Part 1: the digits are one sequence written twice (1212, 55).
+// Integer multiply-and-compare only, no string.
+bool is_invalid(std::uint64_t value);
+
+// Part 2: the digits are one sequence written at least twice (121212, 777).
+bool is_invalid_part2(std::uint64_t value);
+
+// Sums of the part 1 / part 2 invalid IDs in [range.start, range.end], in
+// closed form: O(digits^2) per range however wide it is. Throw
+// std::runtime_error when the sum does not fit in a long long.
+long long invalid_sum(Range range);
+long long invalid_sum_part2(Range range);
+
+// The same sums by testing every ID in the range with a vectorized kernel
+// (8 IDs per instruction with AVX-512), to cross-check the closed form on
+// wide ranges. They wrap modulo 2^64 instead of throwing. `limit` caps the
+// kernel version, so aoc_day02_check can run every one the host supports.
+std::uint64_t scan_invalid_sum(Range range, aoc::Isa limit = aoc::active_isa());
+std::uint64_t scan_invalid_sum_part2(Range range, aoc::Isa limit = aoc::active_isa());
+
+}  // namespace day02
@@ -1,25 +1,26 @@
-#include "aoc.hpp"
+#include "aoc/day.hpp"
+#include "aoc/parallel.hpp"
 
 #include <algorithm>
 #include <cstdlib>   // std::exit
 #include <iostream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 #include <cassert>
 
 using namespace aoc;
 
-static std::string day_input_path(int argc, char **argv) {
-    if (argc > 1) {
-        return argv[1];  // allow custom path
-    }
-    return "../input/day03.txt";
-}
+namespace day03 {
 
-long long solve_part1(const std::vector<std::string> &lines) {
-    long long joltage = 0;
+using Bank = std::vector<int>;
+using Banks = std::vector<Bank>;
+
+Banks parse_banks(Lines lines) {
+    Banks banks;
+    banks.reserve(lines.size());
     for (const auto &line : lines) {
-        std::vector<int> bank;
+        Bank bank;
         bank.reserve(line.size());
 
         for (char c : line) {
@@ -28,28 +29,27 @@ long long solve_part1(const std::vector<std::string> &lines) {
             }
             bank.push_back(c - '0');
         }
+        banks.push_back(std::move(bank));
+    }
+    return banks;
+}
 
+long long solve_part1(const Banks &banks) {
+    return parallel_sum<long long>(0, banks.size(), [&](std::size_t b) {
+        const auto &bank = banks[b];
         // Perform 2 passes over the vector, to find the biggest element
         auto max_it = std::max_element(bank.begin(), bank.end() - 1);
         auto second_max_it = std::max_element(max_it + 1, bank.end());
-        // std::cout << "Line: " << line << " Max: " << *max_it << " Second Max: " << *second_max_it << "\n";
-        joltage += *max_it * 10 + *second_max_it;
-    }
-    return joltage;
+        // std::cout << "Max: " << *max_it << " Second Max: " << *second_max_it << "\n";
+        return static_cast<long long>(*max_it * 10 + *second_max_it);
+    });
 }
 
-long long solve_part2(const std::vector<std::string> &lines) {
-    long long joltage = 0;
-    for (const auto &line : lines) {
-        std::vector<int> bank;
-        bank.reserve(line.size());
-
-        for (char c : line) {
-            if (c < '0' || c > '9') {
-                throw std::runtime_error("Invalid Character");
-            }
-            bank.push_back(c - '0');
-        }
+long long solve_part2(const Banks &banks) {
+    // Banks are solved in parallel, then reported and summed in order
+    std::vector<long long> bank_joltages(banks.size());
+    parallel_for(0, banks.size(), [&](std::size_t b) {
+        const auto &bank = banks[b];
 
         long long bank_joltage{0};
         auto max_it = bank.begin();
@@ -59,31 +59,26 @@ long long solve_part2(const std::vector<std::string> &lines) {
             // std::cout << "  Step " << (12 - i) << ": " << *max_it << " bank_joltage: " << bank_joltage << "\n";
             ++max_it;
         }
-        std::cout << "Line: " << line << " bank_joltage: " << bank_joltage << "\n";
+        bank_joltages[b] = bank_joltage;
+    });
+
+    long long joltage = 0;
+    for (std::size_t b = 0; b < banks.size(); ++b) {
+        const long long bank_joltage = bank_joltages[b];
+        AOC_LOG(debug, "Bank ", b, " bank_joltage: ", bank_joltage);
         assert (joltage + bank_joltage > joltage);
         joltage += bank_joltage;
     }
     return joltage;
 }
 
-int main(int argc, char **argv) {
-    try {
-        const auto input_path = day_input_path(argc, argv);
-        auto lines = read_lines(input_path);
-
-        {
-            auto [ans1, t1] = time_it([&] { return solve_part1(lines); });
-            print_answer(1, ans1, t1);
-        }
+struct Day03 {
+    using Model = Banks;
+    static Model parse(Lines lines) { return parse_banks(lines); }
+    static long long part1(const Model &banks) { return solve_part1(banks); }
+    static long long part2(const Model &banks) { return solve_part2(banks); }
+};
 
-        {
-            auto [ans2, t2] = time_it([&] { return solve_part2(lines); });
-            print_answer(2, ans2, t2);
-        }
+}  // namespace day03
 
-    } catch (const std::exception &e) {
-        std::cerr << "Error: " << e.what() << "\n";
-        return EXIT_FAILURE;
-    }
-    return EXIT_SUCCESS;
-}
\ No newline at end of file
+AOC_REGISTER_DAY(3, day03::Day03, "input/day03.txt")
@@ -1,4 +1,7 @@
-#include "aoc.hpp"
+#include "day04.hpp"
+
+#include "aoc/day.hpp"
+#include "aoc/dispatch.hpp"
 
 #include <cstddef>
 #include <cstdint>
@@ -9,139 +12,113 @@
 
 using namespace aoc;
 
-static std::string day_input_path(int argc, char **argv) {
-    if (argc > 1) {
-        return argv[1];  // allow custom path
-    }
-    return "../input/day04.txt";
-}
+namespace day04 {
 
-std::vector<std::vector<uint8_t>> load_map(const std::vector<std::string> &lines) {
-    std::vector<std::vector<uint8_t>> map;
-    for (const auto &line : lines) {
-        std::vector<uint8_t> row;
-        for (const auto &ch : line) {
-            if (ch == '.') {
-                row.push_back(static_cast<uint8_t>(0));
-            } else if (ch == '@') {
-                row.push_back(static_cast<uint8_t>(1));
-            } else {
-                throw std::runtime_error("Invalid char");
-            }
+Map load_map(Lines lines) {
+    return Map(text_grid(lines), [](char ch) {
+        if (ch == '.') {
+            return false;
         }
-        map.push_back(row);
-    }
-    return map;
+        if (ch == '@') {
+            return true;
+        }
+        throw std::runtime_error("Invalid char");
+    });
 }
 
-bool valid_position(std::vector<std::vector<uint8_t>> map, size_t x, size_t y) {
-    uint8_t count{0U};
-    // Check up, down, left, right
-    // and the diagonals
-    if (y > 0) {
-        count += map[y - 1][x];  // up
-    }
-    if (y + 1 < map.size()) {
-        count += map[y + 1][x];  // down
-    }
-    if (x > 0) {
-        count += map[y][x - 1];  // left
-    }
-    if (x + 1 < map[0].size()) {
-        count += map[y][x + 1];  // right
-    }
-    if (y > 0 && x > 0) {
-        count += map[y - 1][x - 1];  // up-left
-    }
-    if (y > 0 && x + 1 < map[0].size()) {
-        count += map[y - 1][x + 1];  // up-right
-    }
-    if (y + 1 < map.size() && x > 0) {
-        count += map[y + 1][x - 1];  // down-left
-    }
-    if (y + 1 < map.size() && x + 1 < map[0].size()) {
-        count += map[y + 1][x + 1];  // down-right
+bool valid_position(const Map &map, size_t x, size_t y) {
+    // The grid reads empty outside its edges, so all eight neighbours
+    // (up, down, left, right and the diagonals) are read unconditionally
+    const auto cx = static_cast<std::ptrdiff_t>(x);
+    const auto cy = static_cast<std::ptrdiff_t>(y);
+    unsigned count{0U};
+    for (std::ptrdiff_t dy = -1; dy <= 1; ++dy) {
+        for (std::ptrdiff_t dx = -1; dx <= 1; ++dx) {
+            count += map.get(cx + dx, cy + dy) ? 1U : 0U;
+        }
     }
+    // the loop above also counted the cell itself
+    count -= map.get(cx, cy) ? 1U : 0U;
     return count < 4;
 }
 
-int unsigned solve_part1(const std::vector<std::string> &lines) {
-    int unsigned rolls{0};
-    auto map = load_map(lines);
-    // print map for debugging
-    // for (const auto &row : map) {
-    //     for (const auto &cell : row) {
-    //         std::cout << static_cast<int>(cell);
-    //     }
-    //     std::cout << "\n";
-    // }
-
-    for (size_t y{0}; y < map.size(); ++y) {
-        for (size_t x{0}; x < map[0].size(); ++x) {
-            if (map[y][x] == 1) {
-                if (valid_position(map, x, y)) {
-                    ++rolls;
-                }
-            }
-        }
+using Word = BitGrid::Word;
+
+// One row of accessible_rolls. The eight neighbour masks are added up as
+// bit planes (every bit position is its own little counter), so a word
+// tests 64 cells at once: a roll stays when its count has neither the 4
+// nor the 8 bit set.
+[[gnu::always_inline]] inline void accessible_row_body(const Word *up, const Word *mid, const Word *down,
+                                                       std::size_t words, Word *out) {
+    constexpr auto west = [](const Word *r, std::size_t k) { return (r[k] << 1) | (r[k - 1] >> 63); };
+    constexpr auto east = [](const Word *r, std::size_t k) { return (r[k] >> 1) | (r[k + 1] << 63); };
+    // full adder: sum and carry of three bit planes
+    constexpr auto add = [](Word a, Word b, Word c, Word &carry) {
+        carry = (a & b) | (c & (a ^ b));
+        return a ^ b ^ c;
+    };
+
+    for (std::size_t k = 0; k < words; ++k) {
+        Word c0, c1, c2;
+        const Word s0 = add(west(up, k), up[k], east(up, k), c0);
+        const Word s1 = add(west(mid, k), east(mid, k), west(down, k), c1);
+        const Word s2 = add(down[k], east(down, k), 0, c2);
+        Word c3;
+        add(s0, s1, s2, c3);
+        // c0..c3 each count 2; two or more of them make 4 or more
+        Word fours;
+        const Word twos = add(c0, c1, c2, fours);
+        const Word at_least_four = fours | (twos & c3);
+        out[k] = mid[k] & ~at_least_four;
     }
+}
 
-    return rolls;
+AOC_KERNEL_VERSIONS(accessible_row, void,
+                    (const Word *up, const Word *mid, const Word *down, std::size_t words, Word *out),
+                    (up, mid, down, words, out))
+
+Map accessible_rolls(const Map &map) {
+    static const auto accessible_row = select_kernel(accessible_row_versions).fn;
+
+    Map accessible(map.width(), map.height());
+    for (std::size_t y = 0; y < map.height(); ++y) {
+        const auto r = static_cast<std::ptrdiff_t>(y);
+        accessible_row(map.row(r - 1), map.row(r), map.row(r + 1), map.words_per_row(), accessible.row(r));
+    }
+    return accessible;
 }
 
-long long solve_part2(const std::vector<std::string> &lines) {
-    auto map = load_map(lines);
-    // print map for debugging
-    // for (const auto &row : map) {
-        //     for (const auto &cell : row) {
-            //         std::cout << static_cast<int>(cell);
-            //     }
-            //     std::cout << "\n";
-            // }
+int unsigned solve_part1(const Map &map) {
+    return static_cast<int unsigned>(accessible_rolls(map).count());
+}
 
+long long solve_part2(Map map) {
     long long total_rolls{0};
     int unsigned rolls{0};
     do {
-        // Reset the roll count
-        rolls = 0;
-        std::vector<std::pair<uint8_t, uint8_t>> rolls_found;
-        for (size_t y{0}; y < map.size(); ++y) {
-            for (size_t x{0}; x < map[0].size(); ++x) {
-                if (map[y][x] == 1) {
-                    if (valid_position(map, x, y)) {
-                        ++rolls;
-                        rolls_found.push_back({static_cast<uint8_t>(x), static_cast<uint8_t>(y)});
-                    }
-                }
-            }
-        }
+        // Find every accessible roll first, then remove them all at once
+        const Map found = accessible_rolls(map);
+        rolls = static_cast<int unsigned>(found.count());
         total_rolls += rolls;
-        for (const auto &[x, y] : rolls_found) {
-            map[y][x] = 0;
+        for (std::size_t y = 0; y < map.height(); ++y) {
+            const auto r = static_cast<std::ptrdiff_t>(y);
+            for (std::size_t k = 0; k < map.words_per_row(); ++k) {
+                map.row(r)[k] &= ~found.row(r)[k];
+            }
         }
     } while (rolls > 0);
 
     return total_rolls;
 }
 
-int main(int argc, char **argv) {
-    try {
-        const auto input_path = day_input_path(argc, argv);
-        auto lines = read_lines(input_path);
+struct Day04 {
+    using Model = Map;
+    static Model parse(Lines lines) { return load_map(lines); }
+    static int unsigned part1(const Model &map) { return solve_part1(map); }
+    // part 2 removes rolls as it goes, so it works on its own copy
+    static long long part2(const Model &map) { return solve_part2(map); }
+};
 
-        {
-            auto [ans1, t1] = time_it([&] { return solve_part1(lines); });
-            print_answer(1, ans1, t1);
-        }
+}  // namespace day04
 
-        {
-            auto [ans2, t2] = time_it([&] { return solve_part2(lines); });
-            print_answer(2, ans2, t2);
-        }
-
-    } catch (const std::exception &e) {
-        std::cerr << "Error: " << e.what() << "\n";
-        return EXIT_FAILURE;
-    }
-    return EXIT_SUCCESS;
-}
\ No newline at end of file
+AOC_REGISTER_DAY(4, day04::Day04, "input/day04.txt")
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "aoc.hpp"
+#include "aoc/grid.hpp"
+
+#include <cstddef>
+
+// Day 4 kernels, shared with aoc_bench.
+namespace day04 {
+
+// A set bit where a roll of paper ('@') sits.
+using Map = aoc::BitGrid;
+
+Map load_map(aoc::Lines lines);
+
+// True when fewer than four of the eight neighbours of (x, y) hold a roll.
+bool valid_position(const Map &map, size_t x, size_t y);
+
+// Every roll for which valid_position holds, a whole row word at a time.
+Map accessible_rolls(const Map &map);
+
+}  // namespace day04
@@ -1,4 +1,5 @@
-#include "aoc.hpp"
+#include "aoc/day.hpp"
+#include "aoc/parallel.hpp"
 
 #include <cstddef>
 #include <cstdint>
@@ -7,7 +8,6 @@
 #include <stdexcept>
 #include <string>
 
-#include <charconv>
 #include <stdexcept>
 #include <string_view>
 #include <vector>
@@ -15,40 +15,23 @@
 
 using namespace aoc;
 
-static std::string day_input_path(int argc, char **argv) {
-    if (argc > 1) {
-        return argv[1];  // allow custom path
-    }
-    return "../input/day05.txt";
-}
+namespace day05 {
 
 struct Range {
     long long start;
     long long end;
 };
 
-long long parse_ll(std::string_view sv) {
-    long long value{};
-    auto [ptr, ec] = std::from_chars(sv.data(), sv.data() + sv.size(), value);
-    if (ec != std::errc{} || ptr != sv.data() + sv.size()) {
-        throw std::runtime_error("invalid integer: " + std::string(sv));
-    }
-    return value;
-}
-
 Range parse_range_line(std::string_view line) {
-    auto dash_pos = line.find('-');
-    if (dash_pos == std::string_view::npos) {
+    Scanner sc{line};
+
+    Range r{};
+    r.start = sc.next<long long>();
+    if (!sc.consume('-')) {
         throw std::runtime_error("invalid range line (no '-'): " + std::string(line));
     }
-
-    std::string_view left  = line.substr(0, dash_pos);
-    std::string_view right = line.substr(dash_pos + 1);
-
-    Range r{
-        .start = parse_ll(left),
-        .end   = parse_ll(right),
-    };
+    r.end = sc.next<long long>();
+    sc.expect_end();
 
     if (r.start > r.end) {
         throw std::runtime_error("range start > end: " + std::string(line));
@@ -61,9 +44,13 @@ bool in_range(long long value, Range const& range) {
     return value >= range.start && value <= range.end;
 }
 
-long long solve_part1(const std::vector<std::string> &lines) {
-    long long fresh{0};
+struct Inventory {
     std::vector<Range> ranges;
+    std::vector<long long> ids;
+};
+
+Inventory parse_inventory(Lines lines) {
+    Inventory inventory;
 
     bool reading_ranges = true;
 
@@ -71,50 +58,44 @@ long long solve_part1(const std::vector<std::string> &lines) {
         if (line.empty()) {
             // Empty line switches to IDs section
             reading_ranges = false;
-            // Print ranges for debugging
-            // for (const auto& range : ranges) {
-            //     std::cout << "Range: " << range.start << "-" << range.end
-            //     << "\n";
-            // }
             continue;
         }
 
         // Store the ranges
         if (reading_ranges) {
-            ranges.push_back(parse_range_line(line));
+            inventory.ranges.push_back(parse_range_line(line));
         }
-        // Checking IDs
+        // Store the IDs to check
         else {
-            long long ID = parse_ll(line);
-            // std::cout << "ID: " << ID << std::endl;
-            for (const auto& range : ranges) {
-                if (in_range(ID, range)) {
-                    ++fresh;
-                    break;
-                }
-            }
+            inventory.ids.push_back(parse<long long>(line));
         }
     }
-    return fresh;
+    // Print ranges for debugging
+    // for (const auto& range : inventory.ranges) {
+    //     std::cout << "Range: " << range.start << "-" << range.end
+    //     << "\n";
+    // }
+    return inventory;
 }
 
-long long solve_part2(const std::vector<std::string> &lines) {
-    long long fresh{0};
-    std::vector<Range> ranges;
-
-    for (auto const& line : lines) {
-        if (line.empty()) {
-            // Print ranges for debugging
-            // for (const auto& range : ranges) {
-            //     std::cout << "Range: " << range.start << "-" << range.end
-            //     << "\n";
-            // }
-            break;
+long long solve_part1(const Inventory &inventory) {
+    // Checking IDs
+    return parallel_sum<long long>(0, inventory.ids.size(), [&](std::size_t i) {
+        const long long ID = inventory.ids[i];
+        // std::cout << "ID: " << ID << std::endl;
+        for (const auto& range : inventory.ranges) {
+            if (in_range(ID, range)) {
+                return 1LL;
+            }
         }
+        return 0LL;
+    });
+}
 
-        // Store the ranges
-        ranges.push_back(parse_range_line(line));
-    }
+long long solve_part2(const Inventory &inventory) {
+    long long fresh{0};
+    // Sorted below, so work on a copy of the ranges
+    std::vector<Range> ranges = inventory.ranges;
 
     // Sort the ranges by start value
     std::sort(ranges.begin(), ranges.end(), [](Range const& a, Range const& b) {
@@ -155,24 +136,24 @@ long long solve_part2(const std::vector<std::string> &lines) {
     return fresh;
 }
 
-int main(int argc, char **argv) {
-    try {
-        const auto input_path = day_input_path(argc, argv);
-        auto lines = read_lines(input_path);
-
-        {
-            auto [ans1, t1] = time_it([&] { return solve_part1(lines); });
-            print_answer(1, ans1, t1);
-        }
+struct Day05 {
+    using Model = Inventory;
+    static Model parse(Lines lines) { return parse_inventory(lines); }
+    static constexpr std::uint32_t model_version = 1;
+    static void save(const Model &inventory, BinaryWriter &out) {
+        out.put(inventory.ranges);
+        out.put(inventory.ids);
+    }
+    static Model load(BinaryReader &in) {
+        Inventory inventory;
+        inventory.ranges = in.get_vector<Range>();
+        inventory.ids = in.get_vector<long long>();
+        return inventory;
+    }
+    static long long part1(const Model &inventory) { return solve_part1(inventory); }
+    static long long part2(const Model &inventory) { return solve_part2(inventory); }
+};
 
-        {
-            auto [ans2, t2] = time_it([&] { return solve_part2(lines); });
-            print_answer(2, ans2, t2);
-        }
+}  // namespace day05
 
-    } catch (const std::exception &e) {
-        std::cerr << "Error: " << e.what() << "\n";
-        return EXIT_FAILURE;
-    }
-    return EXIT_SUCCESS;
-}
\ No newline at end of file
+AOC_REGISTER_DAY(5, day05::Day05, "input/day05.txt")
@@ -1,4 +1,4 @@
-#include "aoc.hpp"
+#include "aoc/day.hpp"
 
 #include <cstdint>
 #include <cstdlib>   // std::exit
@@ -6,23 +6,28 @@
 #include <stdexcept>
 #include <string>
 #include <vector>
-#include <sstream>
+#include <string_view>
 #include <algorithm>
 #include <cctype>
 #include <utility>
 
 using namespace aoc;
 
-static std::string day_input_path(int argc, char **argv) {
-    if (argc > 1) {
-        return argv[1];  // allow custom path
-    }
-    return "../input/day06.txt";
-}
+namespace day06 {
 
-long long solve_part1(const std::vector<std::string> &lines) {
-    std::vector<std::vector<int unsigned>> math_problems;
-    long long acc{0};
+// Both readings of the worksheet, built in one parse:
+// - part 1 reads each row as whitespace-separated numbers (one vector per column)
+// - part 2 keeps the raw, padded cells so digits can be read top to bottom
+struct Worksheet {
+    std::vector<std::vector<int unsigned>> math_problems;  // part 1 columns
+    std::vector<char> operators;                           // part 1 operators, left to right
+    std::vector<std::pair<char, uint8_t>> op_size;         // part 2 operator and column width
+    std::vector<std::vector<std::string_view>> cells;      // part 2 padded cells per column
+};
+
+void parse_rows(Lines lines, Worksheet &sheet) {
+    auto &math_problems = sheet.math_problems;
+    std::vector<unsigned int> row_values;
     bool operator_line{false};
     for (const auto &line : lines) {
         // Find first non-space character
@@ -36,69 +41,23 @@ long long solve_part1(const std::vector<std::string> &lines) {
 
         // If first non-space is not a digit, assume this is the operator line: 
         if (!std::isdigit(static_cast<unsigned char>(*it))) {
-            // print the math problems for debugging
-            // for (std::size_t col = 0; col < math_problems.size(); ++col) {
-            //     std::cout << "Column " << col << ": ";
-            //     for (const auto &val : math_problems[col]) {
-            //         std::cout << val << " ";
-            //     }
-            //     std::cout << "\n";
-            // }
-            // for (std::size_t row = 0; row < 4; ++row) {
-            //     // print the math problems for debugging
-            //     for (std::size_t col = 0; col < math_problems.size(); ++col) {
-            //         std::cout << math_problems[col][row] << " ";
-            //     }
-            //     std::cout << std::endl;
-            // }
             operator_line = true;
         }
 
         if (operator_line) {
-            // Parse numbers from this line
-            std::istringstream iss(line);
-            char math_op;
-
-            auto column_it = math_problems.begin();
-
-            while (iss >> math_op) {
-                if (column_it == math_problems.end()) {
-                    throw std::runtime_error("More operators than columns");
-                }
-                const auto &column = *column_it;
-                if (column.empty()) {
-                    throw std::runtime_error("Empty column in math_problems");
-                }
-                // Print operator for debug
-                // std::cout << tmp << std::endl;
-                long long math{column.front()};
-
-                for (auto row_it = std::next(column.begin()); row_it != column.end(); ++row_it) {
-                    const auto row = *row_it;
-                    switch (math_op) {
-                        case '*' :
-                            math *= row;
-                            break;
-                        case '+' :
-                            math += row;
-                            break;
-                        default:
-                            throw std::runtime_error("Unsupported operator in input");
-                    }
-                }
-
-                acc += math;
-
-                ++column_it;
+            // Parse operators from this line
+            Scanner sc{line};
+            for (sc.skip_spaces(); !sc.done(); sc.skip_spaces()) {
+                sheet.operators.push_back(sc.peek());
+                sc.advance();
             }
         } else {
             // Parse numbers from this line
-            std::istringstream iss(line);
-            std::vector<unsigned int> row_values;
-            unsigned int tmp;
+            Scanner sc{line};
+            row_values.clear();
 
-            while (iss >> tmp) {
-                row_values.push_back(tmp);
+            for (sc.skip_spaces(); !sc.done(); sc.skip_spaces()) {
+                row_values.push_back(sc.next_u32());
             }
 
             if (row_values.empty()) {
@@ -118,12 +77,18 @@ long long solve_part1(const std::vector<std::string> &lines) {
             }
         }
     }
-    return acc;
+    // print the math problems for debugging
+    // for (std::size_t col = 0; col < math_problems.size(); ++col) {
+    //     std::cout << "Column " << col << ": ";
+    //     for (const auto &val : math_problems[col]) {
+    //         std::cout << val << " ";
+    //     }
+    //     std::cout << "\n";
+    // }
 }
 
-long long solve_part2(const std::vector<std::string> &lines) {
-    std::vector<std::pair<char, uint8_t>> op_size;
-    long long acc{0};
+void parse_columns(Lines lines, Worksheet &sheet) {
+    auto &op_size = sheet.op_size;
     for (const auto &line : lines) {
         // Find first non-space character
         auto it = std::find_if(line.begin(), line.end(),
@@ -148,10 +113,9 @@ long long solve_part2(const std::vector<std::string> &lines) {
         // - the second operator is '*', and the biggest number in the second column is 3 digit wide.
         // - the third operator is '+', and the biggest number in the third column is 2 digit wide.
         // So parse the line to obtain the operators and their sizes.
-        std::istringstream iss(line);
-        char math_op, prev_math_op;
+        char prev_math_op{};
         uint8_t size{0};
-        while(iss.get(math_op)) {
+        for (const char math_op : line) {
             if (math_op == ' ') {
                 ++size;
             } else {
@@ -171,7 +135,7 @@ long long solve_part2(const std::vector<std::string> &lines) {
         // }   
     }
     
-    std::vector<std::vector<std::string>> math_problems;
+    auto &math_problems = sheet.cells;
     // Now parse the numbers knowing the size of each column
     // So if we find spaces, and operator is +, we add 0, if operator is *, we multiply by 1
     for (const auto & line : lines) {        
@@ -181,21 +145,17 @@ long long solve_part2(const std::vector<std::string> &lines) {
         }
         
         // Now parse the numbers according to op_size
-        auto line_it = line.begin();
+        std::size_t line_pos = 0;
         for (size_t col = 0; col < op_size.size(); ++col) {
             auto &[op, sz] = op_size[col];
-            std::string num_str;
-            for (uint8_t i = 0; i < sz && line_it != line.end(); ++i, ++line_it) {
-                num_str += *line_it;
-            }
-            
-            // Store the number as a string
-            std::string number = num_str;
+
+            // Store the number as a view into the line (keeps its padding)
+            std::string_view number = line.substr(std::min(line_pos, line.size()), sz);
             
             // std::cout << "Parsed value: " << number << " with operator: " << op << "\n";
             
             // Move to the next character after the current number
-            ++line_it;
+            line_pos += sz + 1u;
             
             // Store the number in math_problems
             if (math_problems.empty()) {
@@ -212,7 +172,58 @@ long long solve_part2(const std::vector<std::string> &lines) {
             // std::cout << "\n";
         }
     }
+}
+
+Worksheet parse_worksheet(Lines lines) {
+    Worksheet sheet;
+    parse_rows(lines, sheet);
+    parse_columns(lines, sheet);
+    return sheet;
+}
+
+long long solve_part1(const Worksheet &sheet) {
+    const auto &math_problems = sheet.math_problems;
+    long long acc{0};
+
+    auto column_it = math_problems.begin();
+
+    for (const char math_op : sheet.operators) {
+        if (column_it == math_problems.end()) {
+            throw std::runtime_error("More operators than columns");
+        }
+        const auto &column = *column_it;
+        if (column.empty()) {
+            throw std::runtime_error("Empty column in math_problems");
+        }
+        // Print operator for debug
+        // std::cout << tmp << std::endl;
+        long long math{column.front()};
+
+        for (auto row_it = std::next(column.begin()); row_it != column.end(); ++row_it) {
+            const auto row = *row_it;
+            switch (math_op) {
+                case '*' :
+                    math *= row;
+                    break;
+                case '+' :
+                    math += row;
+                    break;
+                default:
+                    throw std::runtime_error("Unsupported operator in input");
+            }
+        }
+
+        acc += math;
+
+        ++column_it;
+    }
+    return acc;
+}
 
+long long solve_part2(const Worksheet &sheet) {
+    const auto &op_size = sheet.op_size;
+    const auto &math_problems = sheet.cells;
+    long long acc{0};
     for (std::size_t col = 0; col < math_problems.size(); ++col) {
         const auto &[op, sz] = op_size[col];
         const auto &column = math_problems[col]; // e.g. {"12", "34", "56"}
@@ -268,24 +279,13 @@ long long solve_part2(const std::vector<std::string> &lines) {
     return acc;
 }
 
-int main(int argc, char **argv) {
-    try {
-        const auto input_path = day_input_path(argc, argv);
-        auto lines = read_lines(input_path);
+struct Day06 {
+    using Model = Worksheet;
+    static Model parse(Lines lines) { return parse_worksheet(lines); }
+    static long long part1(const Model &sheet) { return solve_part1(sheet); }
+    static long long part2(const Model &sheet) { return solve_part2(sheet); }
+};
 
-        {
-            auto [ans1, t1] = time_it([&] { return solve_part1(lines); });
-            print_answer(1, ans1, t1);
-        }
+}  // namespace day06
 
-        {
-            auto [ans2, t2] = time_it([&] { return solve_part2(lines); });
-            print_answer(2, ans2, t2);
-        }
-
-    } catch (const std::exception &e) {
-        std::cerr << "Error: " << e.what() << "\n";
-        return EXIT_FAILURE;
-    }
-    return EXIT_SUCCESS;
-}
\ No newline at end of file
+AOC_REGISTER_DAY(6, day06::Day06, "input/day06.txt")
@@ -1,161 +1,136 @@
-#include "aoc.hpp"
+#include "aoc/day.hpp"
+#include "aoc/grid.hpp"
 
+#include <cstdint>
 #include <cstdlib>   // std::exit
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <utility>
-#include <unordered_set>
 #include <vector>
-#include <unordered_map>
 
 using namespace aoc;
 
-static std::string day_input_path(int argc, char **argv) {
-    if (argc > 1) {
-        return argv[1];  // allow custom path
-    }
-    return "../input/day07.txt";
-}
+namespace day07 {
 
-std::pair<std::vector<std::vector<char>>, std::pair<size_t, size_t>> parse_grid(const std::vector<std::string> &lines) {
-    std::vector<std::vector<char>> grid;
-    std::pair<size_t, size_t> s_coords{-1, -1};
+// Cells outside the manifold read as this; the input only has '.', 'S' and '^'.
+constexpr char outside = ' ';
 
-    for (const auto &line : lines) {
-        grid.emplace_back(line.begin(), line.end());
-    }
+struct Manifold {
+    Grid<char> grid;
+    std::pair<size_t, size_t> s_coords;
+};
+
+Manifold parse_grid(Lines lines) {
+    Grid<char> grid(text_grid(lines), [](char ch) { return ch; }, outside);
+    std::pair<size_t, size_t> s_coords{-1, -1};
 
     // find 'S' coordinates
-    for (size_t r = 0; r < lines.size(); ++r) {
-        for (size_t c = 0; c < lines[r].size(); ++c) {
-            if (lines[r][c] == 'S') {
-                s_coords = {static_cast<int>(r), static_cast<int>(c)};
+    for (size_t r = 0; r < grid.height(); ++r) {
+        for (size_t c = 0; c < grid.width(); ++c) {
+            if (grid.row(static_cast<std::ptrdiff_t>(r))[c] == 'S') {
+                s_coords = {r, c};
             }
         }
     }
-    return {grid, s_coords};
+    return {std::move(grid), s_coords};
 }
 
-void print_grid(const std::vector<std::vector<char>> &grid) {
-    for (const auto &row : grid) {
-        for (const auto &ch : row) {
-            std::cout << ch;
-        }
-        std::cout << "\n";
+std::string format_grid(const Grid<char> &grid) {
+    std::string text;
+    for (size_t r = 0; r < grid.height(); ++r) {
+        text += '\n';
+        text += std::string_view(grid.row(static_cast<std::ptrdiff_t>(r)), grid.width());
     }
+    return text;
 }
 
-long explore_grid_part_1(std::vector<std::vector<char>> &grid, size_t r, size_t c, long split_count) {
-    // Check bounds
-    if (r >= grid.size() || c >= grid[0].size() || r < 0 || c < 0) {
+long explore_grid_part_1(Grid<char> &grid, std::ptrdiff_t r, std::ptrdiff_t c, long split_count) {
+    // The border stops the ray; it never goes up, so one row of it is enough
+    char &cell = grid(c, r);
+    if (cell == outside) {
         return split_count;
     }
 
-    if (grid[r][c] == '^') {
+    if (cell == '^') {
         ++split_count;
         // Split the ray when finding a ^
         split_count = explore_grid_part_1(grid, r, c + 1, split_count);
         split_count = explore_grid_part_1(grid, r, c - 1, split_count);
-    } else if (grid[r][c] != '|') {
-        if (grid[r][c] != 'S') {
-            grid[r][c] = '|';
+    } else if (cell != '|') {
+        if (cell != 'S') {
+            cell = '|';
         }
         split_count = explore_grid_part_1(grid, r + 1, c, split_count);
     }
     return split_count;
 }
 
-long solve_part1(const std::vector<std::string> &lines) {
+long solve_part1(const Manifold &manifold) {
     long split_count{0};
-    auto [grid, s_coords] = parse_grid(lines);
+    // Part 1 marks the visited cells, so it works on its own copy of the grid
+    auto grid = manifold.grid;
+    const auto &s_coords = manifold.s_coords;
 
-    // Print the grid for debugging
-    // print_grid(grid);
-    // std::cout << "S coordinates: (" << s_coords.first << ", " << s_coords.second << ")\n";
+    AOC_LOG(trace, "grid:", format_grid(grid));
+    AOC_LOG(trace, "S coordinates: (", s_coords.first, ", ", s_coords.second, ")");
 
     // Execute the grid exploration from 'S'
-    split_count = explore_grid_part_1(grid, s_coords.first, s_coords.second, split_count);
+    split_count = explore_grid_part_1(grid, static_cast<std::ptrdiff_t>(s_coords.first),
+                                      static_cast<std::ptrdiff_t>(s_coords.second), split_count);
 
-    // print_grid(grid);
+    AOC_LOG(trace, "visited:", format_grid(grid));
 
     return split_count;
 }
 
-using Grid = std::vector<std::vector<char>>;
-struct Coord {
-    size_t r;
-    size_t c;
-
-    bool operator==(const Coord &other) const noexcept {
-        return r == other.r && c == other.c;
-    }
-};
-struct CoordHash {
-    std::size_t operator()(const Coord &p) const noexcept {
-        // simple hash combine
-        std::size_t h1 = std::hash<std::size_t>{}(p.r);
-        std::size_t h2 = std::hash<std::size_t>{}(p.c);
-        return h1 ^ (h2 + 0x9e3779b97f4a7c15ULL + (h1 << 6) + (h1 >> 2));
-    }
-};
-
-using Cache = std::unordered_map<Coord, std::uint64_t, CoordHash>;
+// Paths from each cell, 0 while unknown: every cell leads to at least one.
+using Cache = Grid<std::uint64_t>;
 
 std::uint64_t explore_grid_part_2(
-    const Grid &grid, size_t r, size_t c,
+    const Grid<char> &grid, std::ptrdiff_t r, std::ptrdiff_t c,
     Cache &cache) {
-    // Check bounds
-    if (r >= grid.size() || c >= grid[0].size()) {
+    // Leaving the grid ends one path
+    if (grid(c, r) == outside) {
         return 1;
     }
 
-    Coord key{r, c};
-    if (auto it = cache.find(key); it != cache.end()) {
-        return it->second;
+    std::uint64_t &cached = cache(c, r);
+    if (cached != 0) {
+        return cached;
     }
 
     std::uint64_t result{0};
 
-    if (grid[r][c] == '^') {
+    if (grid(c, r) == '^') {
         // Split the ray when finding a ^
         result += explore_grid_part_2(grid, r, c + 1, cache);
-        if (c > 0) result += explore_grid_part_2(grid, r, c - 1, cache);
-        else ++result;
+        result += explore_grid_part_2(grid, r, c - 1, cache);
     } else {
         result = explore_grid_part_2(grid, r + 1, c, cache);
     }
-    cache[key] = result;
+    cached = result;
     return result;
 }
 
-long long solve_part2(const std::vector<std::string> &lines) {
-    auto [grid, s_coords] = parse_grid(lines);
+long long solve_part2(const Manifold &manifold) {
+    const auto &[grid, s_coords] = manifold;
 
-    Cache cache;
+    Cache cache(grid.width(), grid.height(), 0, 0);
     // Execute the grid exploration from 'S'
-    std::uint64_t number_of_paths = explore_grid_part_2(grid, s_coords.first, s_coords.second, cache);
+    std::uint64_t number_of_paths = explore_grid_part_2(grid, static_cast<std::ptrdiff_t>(s_coords.first),
+                                                        static_cast<std::ptrdiff_t>(s_coords.second), cache);
 
     return static_cast<long long>(number_of_paths);
 }
 
-int main(int argc, char **argv) {
-    try {
-        const auto input_path = day_input_path(argc, argv);
-        auto lines = read_lines(input_path);
-
-        {
-            auto [ans1, t1] = time_it([&] { return solve_part1(lines); });
-            print_answer(1, ans1, t1);
-        }
+struct Day07 {
+    using Model = Manifold;
+    static Model parse(Lines lines) { return parse_grid(lines); }
+    static long part1(const Model &manifold) { return solve_part1(manifold); }
+    static long long part2(const Model &manifold) { return solve_part2(manifold); }
+};
 
-        {
-            auto [ans2, t2] = time_it([&] { return solve_part2(lines); });
-            print_answer(2, ans2, t2);
-        }
+}  // namespace day07
 
-    } catch (const std::exception &e) {
-        std::cerr << "Error: " << e.what() << "\n";
-        return EXIT_FAILURE;
-    }
-    return EXIT_SUCCESS;
-}
\ No newline at end of file
+AOC_REGISTER_DAY(7, day07::Day07, "input/day07.txt")
@@ -1,52 +1,26 @@
-#include "aoc.hpp"
+#include "day08.hpp"
 
+#include "aoc/day.hpp"
+#include "aoc/dispatch.hpp"
+
+#include <compare>
+#include <cstdint>
 #include <cstdlib>   // std::exit
 #include <iostream>
 #include <array>
-#include <charconv>
+#include <limits>
 #include <stdexcept>
 #include <string>
 #include <string_view>
 #include <utility>
 #include <vector>
-#include <ranges>
 #include <cmath>
 #include <unordered_set>
 #include <algorithm>
 
 using namespace aoc;
 
-static std::string day_input_path(int argc, char **argv) {
-    if (argc > 1) {
-        return argv[1];  // allow custom path
-    }
-    return "../input/day08.txt";
-}
-
-struct Coord {
-    int unsigned x;
-    int unsigned y;
-    int unsigned z;
-
-    bool operator== (const Coord &other) const noexcept {
-        return x == other.x && y == other.y && z == other.z;
-    }
-
-    [[nodiscard]]
-    constexpr double distance_to(const Coord &other) const noexcept {
-        // use signed differences to avoid unsigned underflow
-        const auto dx = static_cast<long long>(x) - static_cast<long long>(other.x);
-        const auto dy = static_cast<long long>(y) - static_cast<long long>(other.y);
-        const auto dz = static_cast<long long>(z) - static_cast<long long>(other.z);
-
-        // C++17+ has std::hypot(dx, dy, dz)
-        // This is not constexpr until C++26, so this function will be constexpr-ish
-        // only for compilers that extend it; but the signature is fine.
-        return std::hypot(std::hypot(static_cast<double>(dx),
-                                     static_cast<double>(dy)),
-                          static_cast<double>(dz));
-    }
-};
+namespace day08 {
 
 struct CoordHash {
     std::size_t operator()(const Coord &p) const noexcept {
@@ -58,53 +32,36 @@ struct CoordHash {
     }
 };
 
-using Coords = std::vector<Coord>;
-
-int unsigned parse_ll(std::string_view sv) {
-    int unsigned value{};
-    auto [ptr, ec] = std::from_chars(sv.data(), sv.data() + sv.size(), value);
-    if (ec != std::errc{} || ptr != sv.data() + sv.size()) {
-        throw std::runtime_error("invalid integer: " + std::string(sv));
-    }
-    return value;
-}
-
-Coords parse_input(const std::vector<std::string> &lines) {
+Coords parse_input(Lines lines) {
+    AOC_ZONE("parse");
     Coords coords;
     coords.reserve(lines.size());
 
+    DelimiterOffsets offsets;
+
     for (const auto &line : lines) {
         if (line.empty()) {
             continue;
         }
 
-        auto comma_split = line | std::views::split(',');
-
-        std::array<std::string_view, 3> pieces{};
-        std::size_t idx = 0;
-
-        for (auto &&part : comma_split) {
-            if (idx >= pieces.size()) {
-                throw std::runtime_error("too many fields in line: " + line);
-            }
-
-            // part is a range of chars; build a string_view over it
-            std::string_view sv{
-                &*part.begin(),
-                static_cast<std::size_t>(std::ranges::distance(part))
-            };
-            pieces[idx++] = sv;
+        scan_delimiters(line, comma, offsets);
+        if (offsets.fields.size() > 2) {
+            throw std::runtime_error("too many fields in line: " + std::string(line));
         }
-
-        if (idx != pieces.size()) {
-            throw std::runtime_error("too few fields in line: " + line);
+        if (offsets.fields.size() < 2) {
+            throw std::runtime_error("too few fields in line: " + std::string(line));
         }
 
-        coords.push_back(Coord{
-            .x = parse_ll(pieces[0]),
-            .y = parse_ll(pieces[1]),
-            .z = parse_ll(pieces[2]),
-        });
+        std::array<std::string_view, 3> pieces{};
+        std::size_t idx = 0;
+        for_each_field(line, offsets.fields, [&](std::string_view sv) { pieces[idx++] = sv; });
+
+        const Coord coord{
+            .x = parse<int unsigned>(pieces[0]),
+            .y = parse<int unsigned>(pieces[1]),
+            .z = parse<int unsigned>(pieces[2]),
+        };
+        coords.push_back(coord);
     }
 
     // Print coords for debugging
@@ -116,23 +73,71 @@ Coords parse_input(const std::vector<std::string> &lines) {
     return coords;
 }
 
-using CoordMatrix = std::vector<std::vector<double>>;
+// A squared Euclidean distance, exact for any unsigned coordinates: each
+// squared difference fits in 64 bits, but their sum needs up to 66, so it
+// is kept as the carries into `high` and the low 64 bits. Only the order of
+// the distances matters, so no square root is taken.
+struct SquaredDistance {
+    std::uint64_t high;
+    std::uint64_t low;
+
+    auto operator<=>(const SquaredDistance &) const = default;
+};
+
+// Marks a pair on or below the diagonal, or one already connected; larger
+// than every real distance, whose high word is at most 2.
+constexpr SquaredDistance used_distance{std::numeric_limits<std::uint64_t>::max(),
+                                        std::numeric_limits<std::uint64_t>::max()};
+
+using CoordMatrix = std::vector<std::vector<SquaredDistance>>;
+
+// One row of the distance matrix from coordinates split into x, y and z
+// arrays: used_distance up to the diagonal, the squared distance after it.
+// The differences are below 2^32 in magnitude, so their squares are exact in
+// uint64 whatever the sign.
+[[gnu::always_inline]] inline void distance_row_body(const std::int64_t *xs, const std::int64_t *ys,
+                                                     const std::int64_t *zs, std::size_t n, std::size_t i,
+                                                     SquaredDistance *row) {
+    for (std::size_t j = 0; j <= i; ++j) {
+        row[j] = used_distance;
+    }
+    const std::int64_t x = xs[i];
+    const std::int64_t y = ys[i];
+    const std::int64_t z = zs[i];
+    for (std::size_t j = i + 1; j < n; ++j) {
+        const auto dx = static_cast<std::uint64_t>(xs[j] - x);
+        const auto dy = static_cast<std::uint64_t>(ys[j] - y);
+        const auto dz = static_cast<std::uint64_t>(zs[j] - z);
+        const std::uint64_t xx = dx * dx;
+        const std::uint64_t xy = xx + dy * dy;
+        const std::uint64_t xyz = xy + dz * dz;
+        row[j] = {static_cast<std::uint64_t>(xy < xx) + static_cast<std::uint64_t>(xyz < xy), xyz};
+    }
+}
+
+AOC_KERNEL_VERSIONS(distance_row, void,
+                    (const std::int64_t *xs, const std::int64_t *ys, const std::int64_t *zs, std::size_t n,
+                     std::size_t i, SquaredDistance *row),
+                    (xs, ys, zs, n, i, row))
 
 // The distance matrix should only be one sided; distance from A to B is same as B to A
 CoordMatrix compute_distance_matrix(const Coords &coords) {
-    CoordMatrix distance_matrix;
-    distance_matrix.resize(coords.size());
-    for (std::size_t i = 0; i < coords.size(); ++i)
-    {
-        distance_matrix[i].resize(coords.size());
-        for (std::size_t j = 0; j < coords.size(); ++j)
-        {
-            double dist{-1.0};
-            if (j > i) {
-                dist = coords[i].distance_to(coords[j]);
-            }
-            distance_matrix[i][j] = dist;
-        }
+    AOC_ZONE("build distance matrix");
+    static const auto distance_row = select_kernel(distance_row_versions).fn;
+
+    const std::size_t n = coords.size();
+    std::vector<std::int64_t> xs(n);
+    std::vector<std::int64_t> ys(n);
+    std::vector<std::int64_t> zs(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        xs[i] = coords[i].x;
+        ys[i] = coords[i].y;
+        zs[i] = coords[i].z;
+    }
+
+    CoordMatrix distance_matrix(n, std::vector<SquaredDistance>(n));
+    for (std::size_t i = 0; i < n; ++i) {
+        distance_row(xs.data(), ys.data(), zs.data(), n, i, distance_matrix[i].data());
     }
 
     // Print distance matrix for debugging
@@ -148,44 +153,59 @@ CoordMatrix compute_distance_matrix(const Coords &coords) {
 using Pair = std::pair<size_t, size_t>;
 
 // Get the entries pair with the smallest distance in the matrix
-// the distance must be different from -1
+// the distance must be different from used_distance
 Pair get_smallest_distance(const CoordMatrix &matrix) {
-    double smallest_distance = -1.0;
+    AOC_ZONE("smallest distance");
+    SquaredDistance smallest_distance = used_distance;
     Pair coords{-1, -1};
 
     for (size_t i = 0; i < matrix.size(); ++i) {
         for (size_t j = 0; j < matrix[i].size(); ++j) {
-            double dist = matrix[i][j];
-            if (dist != -1.0) {
-                if (smallest_distance == -1.0 || dist < smallest_distance) {
-                    smallest_distance = dist;
-                    coords = {i, j};
-                }
+            const SquaredDistance &dist = matrix[i][j];
+            if (dist < smallest_distance) {
+                smallest_distance = dist;
+                coords = {i, j};
             }
         }
     }
     return coords;
 }
 
-using JunctionBox = std::unordered_set<Coord, CoordHash>;
-using VectorJunctionBoxes = std::vector<JunctionBox>;
+// Parsed coordinates plus their pairwise distances, built once and shared by both parts
+struct Playground {
+    Coords coords;
+    CoordMatrix distance_matrix;
+};
 
-long long solve_part1(const std::vector<std::string> &lines) {
+Playground parse_playground(Lines lines) {
     Coords coords = parse_input(lines);
 
     // Compute the 2D matrix of distances
     CoordMatrix distance_matrix = compute_distance_matrix(coords);
 
+    return {std::move(coords), std::move(distance_matrix)};
+}
+
+using JunctionBox = std::unordered_set<Coord, CoordHash>;
+using VectorJunctionBoxes = std::vector<JunctionBox>;
+
+long long solve_part1(const Playground &playground) {
+    const Coords &coords = playground.coords;
+
+    // Used distances get marked with used_distance, so work on a copy of the matrix
+    CoordMatrix distance_matrix = playground.distance_matrix;
+
     VectorJunctionBoxes junction_boxes;
 
     for (size_t ite{0}; ite < 10; ++ite) {
+        AOC_ZONE("union step");
         Pair closest = get_smallest_distance(distance_matrix);
-        // std::cout << "Closest pair: (" << coords[closest.first].x << ", " << coords[closest.first].y << ", " << coords[closest.first].z << ") <-> ("
-        //           << coords[closest.second].x << ", " << coords[closest.second].y << ", " << coords[closest.second].z << ")\n";
+        AOC_LOG(trace, "Closest pair: (", coords[closest.first].x, ", ", coords[closest.first].y, ", ", coords[closest.first].z, ") <-> (",
+                coords[closest.second].x, ", ", coords[closest.second].y, ", ", coords[closest.second].z, ")");
 
         // Mark this distance as used
-        distance_matrix[closest.first][closest.second] = -1.0;
-        distance_matrix[closest.second][closest.first] = -1.0;
+        distance_matrix[closest.first][closest.second] = used_distance;
+        distance_matrix[closest.second][closest.first] = used_distance;
 
         // Find if closest.first or closest.second are already in a junction box
         bool found_box_first{false};
@@ -256,29 +276,30 @@ long long solve_part1(const std::vector<std::string> &lines) {
     return static_cast<long long>(junction_boxes[0].size()) * static_cast<long long>(junction_boxes[1].size()) * static_cast<long long>(junction_boxes[2].size());
 }
 
-long long solve_part2(const std::vector<std::string> &lines) {
-    Coords coords = parse_input(lines);
+long long solve_part2(const Playground &playground) {
+    const Coords &coords = playground.coords;
 
-    // Compute the 2D matrix of distances
-    CoordMatrix distance_matrix = compute_distance_matrix(coords);
+    // Used distances get marked with used_distance, so work on a copy of the matrix
+    CoordMatrix distance_matrix = playground.distance_matrix;
 
     VectorJunctionBoxes junction_boxes;
 
     long long result{0};
 
     while (true) {
+        AOC_ZONE("union step");
         Pair closest = get_smallest_distance(distance_matrix);
         if (closest.first == static_cast<size_t>(-1) ||
             closest.second == static_cast<size_t>(-1)) {
             // No more pairs
             break;
         }
-        // std::cout << "Closest pair: (" << coords[closest.first].x << ", " << coords[closest.first].y << ", " << coords[closest.first].z << ") <-> ("
-        //           << coords[closest.second].x << ", " << coords[closest.second].y << ", " << coords[closest.second].z << ")\n";
+        AOC_LOG(trace, "Closest pair: (", coords[closest.first].x, ", ", coords[closest.first].y, ", ", coords[closest.first].z, ") <-> (",
+                coords[closest.second].x, ", ", coords[closest.second].y, ", ", coords[closest.second].z, ")");
 
         // Mark this distance as used
-        distance_matrix[closest.first][closest.second] = -1.0;
-        distance_matrix[closest.second][closest.first] = -1.0;
+        distance_matrix[closest.first][closest.second] = used_distance;
+        distance_matrix[closest.second][closest.first] = used_distance;
 
         result = coords[closest.first].x * coords[closest.second].x;
 
@@ -333,7 +354,7 @@ long long solve_part2(const std::vector<std::string> &lines) {
 
         }
         if (junction_boxes.size() == 1 && junction_boxes[0].size() == coords.size()) {
-            std::cout << "All coords are in one junction box; terminating.\n";
+            AOC_LOG(info, "All coords are in one junction box; terminating.");
             break;
         }
     }
@@ -350,24 +371,34 @@ long long solve_part2(const std::vector<std::string> &lines) {
     return result;
 }
 
-int main(int argc, char **argv) {
-    try {
-        const auto input_path = day_input_path(argc, argv);
-        auto lines = read_lines(input_path);
-
-        {
-            auto [ans1, t1] = time_it([&] { return solve_part1(lines); });
-            print_answer(1, ans1, t1);
+struct Day08 {
+    using Model = Playground;
+    static Model parse(Lines lines) { return parse_playground(lines); }
+    // The distance matrix is stored too: building it is most of the parse.
+    static constexpr std::uint32_t model_version = 4;  // 4: exact 66-bit squared distances
+    static void save(const Model &playground, BinaryWriter &out) {
+        out.put(playground.coords);
+        out.put(static_cast<std::uint64_t>(playground.distance_matrix.size()));
+        for (const auto &row : playground.distance_matrix) {
+            out.put(row);
         }
-
-        {
-            auto [ans2, t2] = time_it([&] { return solve_part2(lines); });
-            print_answer(2, ans2, t2);
+    }
+    static Model load(BinaryReader &in) {
+        Playground playground;
+        playground.coords = in.get_vector<Coord>();
+        if (in.get<std::uint64_t>() != playground.coords.size()) {
+            throw std::runtime_error("model cache: distance matrix does not match the coordinates");
         }
-
-    } catch (const std::exception &e) {
-        std::cerr << "Error: " << e.what() << "\n";
-        return EXIT_FAILURE;
+        playground.distance_matrix.resize(playground.coords.size());
+        for (auto &row : playground.distance_matrix) {
+            row = in.get_vector<SquaredDistance>();
+        }
+        return playground;
     }
-    return EXIT_SUCCESS;
-}
\ No newline at end of file
+    static long long part1(const Model &playground) { return solve_part1(playground); }
+    static long long part2(const Model &playground) { return solve_part2(playground); }
+};
+
+}  // namespace day08
+
+AOC_REGISTER_DAY(8, day08::Day08, "input/day08.txt")
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "aoc.hpp"
+
+#include <cmath>
+#include <vector>
+
+// Day 8 kernels, shared with aoc_bench.
+namespace day08 {
+
+struct Coord {
+    int unsigned x;
+    int unsigned y;
+    int unsigned z;
+
+    bool operator== (const Coord &other) const noexcept {
+        return x == other.x && y == other.y && z == other.z;
+    }
+
+    [[nodiscard]]
+    constexpr double distance_to(const Coord &other) const noexcept {
+        // use signed differences to avoid unsigned underflow
+        const auto dx = static_cast<long long>(x) - static_cast<long long>(other.x);
+        const auto dy = static_cast<long long>(y) - static_cast<long long>(other.y);
+        const auto dz = static_cast<long long>(z) - static_cast<long long>(other.z);
+
+        // C++17+ has std::hypot(dx, dy, dz)
+        // This is not constexpr until C++26, so this function will be constexpr-ish
+        // only for compilers that extend it; but the signature is fine.
+        return std::hypot(std::hypot(static_cast<double>(dx),
+                                     static_cast<double>(dy)),
+                          static_cast<double>(dz));
+    }
+};
+
+using Coords = std::vector<Coord>;
+
+Coords parse_input(aoc::Lines lines);
+
+}  // namespace day08
@@ -1,87 +1,48 @@
-#include "aoc.hpp"
+#include "day09.hpp"
+
+#include "aoc/day.hpp"
+#include "aoc/dispatch.hpp"
+#include "aoc/parallel.hpp"
 
 #include <cstdlib>
 #include <iostream>
 #include <stdexcept>
 #include <string>
-#include <ranges>
-#include <charconv>
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 
 using namespace aoc;
 
-static std::string day_input_path(int argc, char **argv) {
-    if (argc > 1) {
-        return argv[1];  // allow custom path
-    }
-    return "../input/day09.txt";
-}
-
-struct Coord {
-    int unsigned x;
-    int unsigned y;
-
-    bool operator== (const Coord &other) const noexcept {
-        return x == other.x && y == other.y;
-    }
-
-    [[nodiscard]]
-    constexpr long area(const Coord &other) const noexcept {
-        // Compute the area of the rectangle defined by this and other
-        // corners. Note that the module of the difference is used to ensure
-        // a positive area regardless of the order of the corners.
-        const long width = static_cast<long>(std::abs(static_cast<long>(x) - static_cast<long>(other.x))) + 1;
-        const long height = static_cast<long>(std::abs(static_cast<long>(y) - static_cast<long>(other.y))) + 1;
-        return std::abs(width * height);
-    }
-};
-
-using Coords = std::vector<Coord>;
-
-int unsigned parse_ll(std::string_view sv) {
-    int unsigned value{};
-    auto [ptr, ec] = std::from_chars(sv.data(), sv.data() + sv.size(), value);
-    if (ec != std::errc{} || ptr != sv.data() + sv.size()) {
-        throw std::runtime_error("invalid integer: " + std::string(sv));
-    }
-    return value;
-}
+namespace day09 {
 
-Coords parse_input(const std::vector<std::string> &lines) {
+Coords parse_input(Lines lines) {
+    AOC_ZONE("parse");
     Coords coords;
     coords.reserve(lines.size());
 
+    DelimiterOffsets offsets;
+
     for (const auto &line : lines) {
         if (line.empty()) {
             continue;
         }
 
-        auto comma_split = line | std::views::split(',');
+        scan_delimiters(line, comma, offsets);
+        if (offsets.fields.size() > 1) {
+            throw std::runtime_error("too many fields in line: " + std::string(line));
+        }
+        if (offsets.fields.size() < 1) {
+            throw std::runtime_error("too few fields in line: " + std::string(line));
+        }
 
         std::array<std::string_view, 2> pieces{};
         std::size_t idx = 0;
-
-        for (auto &&part : comma_split) {
-            if (idx >= pieces.size()) {
-                throw std::runtime_error("too many fields in line: " + line);
-            }
-
-            // part is a range of chars; build a string_view over it
-            std::string_view sv{
-                &*part.begin(),
-                static_cast<std::size_t>(std::ranges::distance(part))
-            };
-            pieces[idx++] = sv;
-        }
-
-        if (idx != pieces.size()) {
-            throw std::runtime_error("too few fields in line: " + line);
-        }
+        for_each_field(line, offsets.fields, [&](std::string_view sv) { pieces[idx++] = sv; });
 
         coords.push_back(Coord{
-            .x = parse_ll(pieces[0]),
-            .y = parse_ll(pieces[1])
+            .x = parse<int unsigned>(pieces[0]),
+            .y = parse<int unsigned>(pieces[1])
         });
     }
 
@@ -93,95 +54,84 @@ Coords parse_input(const std::vector<std::string> &lines) {
     return coords;
 }
 
-long long solve_part1(const std::vector<std::string> &lines) {
-    Coords coords = parse_input(lines);
-
-    long long biggest_area{0};
-    for (size_t c1{0}; c1 < coords.size(); ++c1) {
+long long solve_part1(const Coords &coords) {
+    const auto max = [](long long a, long long b) { return std::max(a, b); };
+    return parallel_reduce(0, coords.size(), 0LL, [&](size_t c1) {
+        long long biggest_area{0};
         for (size_t c2{c1}; c2 < coords.size(); ++c2) {
             long long area = coords[c1].area(coords[c2]);
             biggest_area = std::max(area, biggest_area);
             // Print area for debug
             // std::cout << "(" << coords[c1].x << "," << coords[c1].y << ")x(" << coords[c2].x << "," << coords[c2].y << ")=" << area << std::endl;
         }
-    }
-
-    return biggest_area;
+        return biggest_area;
+    }, max);
 }
 
-struct Rect {
-    unsigned min_x;
-    unsigned max_x;
-    unsigned min_y;
-    unsigned max_y;
+struct Edge { Coord a, b; bool vertical; };
+
+// The polygon edges split by orientation into flat arrays, so the interior
+// test runs over all of them as one vectorizable loop.
+struct EdgeLists {
+    std::vector<unsigned> v_x, v_min_y, v_max_y;  // vertical edges
+    std::vector<unsigned> h_y, h_min_x, h_max_x;  // horizontal edges
+
+    void add(const Edge &edge) {
+        if (edge.vertical) {
+            v_x.push_back(edge.a.x);
+            v_min_y.push_back(std::min(edge.a.y, edge.b.y));
+            v_max_y.push_back(std::max(edge.a.y, edge.b.y));
+        } else {
+            h_y.push_back(edge.a.y);
+            h_min_x.push_back(std::min(edge.a.x, edge.b.x));
+            h_max_x.push_back(std::max(edge.a.x, edge.b.x));
+        }
+    }
 };
 
-[[nodiscard]]
-constexpr Rect make_rect(const Coord& a, const Coord& b) noexcept {
-    return {
-        .min_x = std::min(a.x, b.x),
-        .max_x = std::max(a.x, b.x),
-        .min_y = std::min(a.y, b.y),
-        .max_y = std::max(a.y, b.y),
-    };
+// vertical_edge_crosses_interior / horizontal_edge_crosses_interior over
+// every edge, without branches.
+[[gnu::always_inline]] inline bool any_edge_crosses_body(const EdgeLists &edges, const Rect &r) {
+    unsigned hit = 0;
+    for (std::size_t k = 0; k < edges.v_x.size(); ++k) {
+        hit |= static_cast<unsigned>(r.min_x < edges.v_x[k]) & static_cast<unsigned>(edges.v_x[k] < r.max_x) &
+               static_cast<unsigned>(edges.v_max_y[k] > r.min_y) & static_cast<unsigned>(edges.v_min_y[k] < r.max_y);
+    }
+    for (std::size_t k = 0; k < edges.h_y.size(); ++k) {
+        hit |= static_cast<unsigned>(r.min_y < edges.h_y[k]) & static_cast<unsigned>(edges.h_y[k] < r.max_y) &
+               static_cast<unsigned>(edges.h_max_x[k] > r.min_x) & static_cast<unsigned>(edges.h_min_x[k] < r.max_x);
+    }
+    return hit != 0;
 }
 
-[[nodiscard]]
-constexpr bool vertical_edge_crosses_interior(const Coord& e1,
-                                              const Coord& e2,
-                                              const Rect& r) noexcept
-{
-    // assume e1.x == e2.x
-    const auto x = e1.x;
-    const auto e_min_y = std::min(e1.y, e2.y);
-    const auto e_max_y = std::max(e1.y, e2.y);
-
-    const bool x_inside  = (r.min_x < x && x < r.max_x);
-    const bool y_overlap = !(e_max_y <= r.min_y || e_min_y >= r.max_y);
-    return x_inside && y_overlap;
-}
-
-[[nodiscard]]
-constexpr bool horizontal_edge_crosses_interior(const Coord& e1,
-                                                const Coord& e2,
-                                                const Rect& r) noexcept
-{
-    // assume e1.y == e2.y
-    const auto y = e1.y;
-    const auto e_min_x = std::min(e1.x, e2.x);
-    const auto e_max_x = std::max(e1.x, e2.x);
-
-    const bool y_inside  = (r.min_y < y && y < r.max_y);
-    const bool x_overlap = !(e_max_x <= r.min_x || e_min_x >= r.max_x);
-    return y_inside && x_overlap;
-}
-
-struct Edge { Coord a, b; bool vertical; };
+AOC_KERNEL_VERSIONS(any_edge_crosses, bool, (const EdgeLists &edges, const Rect &r), (edges, r))
 
 [[nodiscard]]
 constexpr bool is_axis_aligned(const Coord& a, const Coord& b) noexcept {
     return (a.x == b.x) || (a.y == b.y);
 }
 
-long long solve_part2(const std::vector<std::string> &lines) {
-    const Coords coords = parse_input(lines);
+long long solve_part2(const Coords &coords) {
     const size_t n = coords.size();
 
+    static const auto any_edge_crosses = select_kernel(any_edge_crosses_versions).fn;
 
-    std::vector<Edge> edges;
-    edges.reserve(n);
+    EdgeLists edges;
     for (std::size_t e = 0; e < n; ++e) {
         const auto& a = coords[e];
         const auto& b = coords[(e + 1) % n];
 
         assert (is_axis_aligned(a, b));
         // verify axis-aligned and push
-        edges.emplace_back(Edge{a, b, a.x == b.x});
+        edges.add(Edge{a, b, a.x == b.x});
     }
 
-    long long biggest_area{0};
+    // Shared across rows so every thread prunes against the best area found so far
+    std::atomic<long long> biggest_area{0};
 
-    for (size_t c1{0}; c1 < n; ++c1) {
+    // Later rows have fewer pairs, so hand rows out one at a time
+    parallel_for(0, n, [&](size_t c1) {
+        AOC_ZONE("candidate row");
         const auto &coord1 = coords[c1];
 
         for (size_t c2{c1}; c2 < n; ++c2) {
@@ -190,57 +140,35 @@ long long solve_part2(const std::vector<std::string> &lines) {
             const long long area = coord1.area(coord2);
             // If the new pair creates an area bigger than the biggest
             // Check if there's no coord that lives inside that reg
-            if (area > biggest_area) {
+            if (area > biggest_area.load(std::memory_order_relaxed)) {
+                AOC_ZONE("edge check");
                 // std::cout << "TESTING: (" << coord1.x << "," << coord1.y << ")x(" << coord2.x << "," << coord2.y << ")=" << area << std::endl;
-                bool valid_area{true};
-
                 const Rect rect = make_rect(coord1, coord2);
-                for (const auto &edge : edges) {
-                    // Vertical edge
-                    if (edge.vertical) {
-                        if (vertical_edge_crosses_interior(edge.a, edge.b, rect)) {
-                            valid_area = false;
-                            // std::cout << "not valid" << std::endl;
-                        }
-                    }
-                    // Horizontal edge
-                    else {
-                        if (horizontal_edge_crosses_interior(edge.a, edge.b, rect)) {
-                            valid_area = false;
-                            // std::cout << "not valid" << std::endl;
-                        }
-                    }
-                }
+                const bool valid_area = !any_edge_crosses(edges, rect);
 
                 if (valid_area) {
-                    biggest_area = std::max(area, biggest_area);
+                    long long seen = biggest_area.load(std::memory_order_relaxed);
+                    while (area > seen && !biggest_area.compare_exchange_weak(seen, area)) {
+                    }
                     // std::cout << "(" << coord1.x << "," << coord1.y << ")x(" << coord2.x << "," << coord2.y << ")=" << area << std::endl;
                 }
             }
         }
-    }
+    }, 1);
 
-    return biggest_area;
+    return biggest_area.load();
 }
 
-int main(int argc, char **argv) {
-    try {
-        const auto input_path = day_input_path(argc, argv);
-        auto lines = read_lines(input_path);
-
-        {
-            auto [ans1, t1] = time_it([&] { return solve_part1(lines); });
-            print_answer(1, ans1, t1);
-        }
+struct Day09 {
+    using Model = Coords;
+    static Model parse(Lines lines) { return parse_input(lines); }
+    static constexpr std::uint32_t model_version = 1;
+    static void save(const Model &coords, BinaryWriter &out) { out.put(coords); }
+    static Model load(BinaryReader &in) { return in.get_vector<Coord>(); }
+    static long long part1(const Model &coords) { return solve_part1(coords); }
+    static long long part2(const Model &coords) { return solve_part2(coords); }
+};
 
-        {
-            auto [ans2, t2] = time_it([&] { return solve_part2(lines); });
-            print_answer(2, ans2, t2);
-        }
+}  // namespace day09
 
-    } catch (const std::exception &e) {
-        std::cerr << "Error: " << e.what() << "\n";
-        return EXIT_FAILURE;
-    }
-    return EXIT_SUCCESS;
-}
\ No newline at end of file
+AOC_REGISTER_DAY(9, day09::Day09, "input/day09.txt")
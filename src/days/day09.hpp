@@ -0,0 +1,82 @@
+#pragma once
+
+#include "aoc.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+// Day 9 kernels, shared with aoc_bench.
+namespace day09 {
+
+struct Coord {
+    int unsigned x;
+    int unsigned y;
+
+    bool operator== (const Coord &other) const noexcept {
+        return x == other.x && y == other.y;
+    }
+
+    [[nodiscard]]
+    long area(const Coord &other) const noexcept {
+        // Compute the area of the rectangle defined by this and other
+        // corners. Note that the module of the difference is used to ensure
+        // a positive area regardless of the order of the corners.
+        const long width = static_cast<long>(std::abs(static_cast<long>(x) - static_cast<long>(other.x))) + 1;
+        const long height = static_cast<long>(std::abs(static_cast<long>(y) - static_cast<long>(other.y))) + 1;
+        return std::abs(width * height);
+    }
+};
+
+using Coords = std::vector<Coord>;
+
+Coords parse_input(aoc::Lines lines);
+
+struct Rect {
+    unsigned min_x;
+    unsigned max_x;
+    unsigned min_y;
+    unsigned max_y;
+};
+
+[[nodiscard]]
+constexpr Rect make_rect(const Coord& a, const Coord& b) noexcept {
+    return {
+        .min_x = std::min(a.x, b.x),
+        .max_x = std::max(a.x, b.x),
+        .min_y = std::min(a.y, b.y),
+        .max_y = std::max(a.y, b.y),
+    };
+}
+
+[[nodiscard]]
+constexpr bool vertical_edge_crosses_interior(const Coord& e1,
+                                              const Coord& e2,
+                                              const Rect& r) noexcept
+{
+    // assume e1.x == e2.x
+    const auto x = e1.x;
+    const auto e_min_y = std::min(e1.y, e2.y);
+    const auto e_max_y = std::max(e1.y, e2.y);
+
+    const bool x_inside  = (r.min_x < x && x < r.max_x);
+    const bool y_overlap = !(e_max_y <= r.min_y || e_min_y >= r.max_y);
+    return x_inside && y_overlap;
+}
+
+[[nodiscard]]
+constexpr bool horizontal_edge_crosses_interior(const Coord& e1,
+                                                const Coord& e2,
+                                                const Rect& r) noexcept
+{
+    // assume e1.y == e2.y
+    const auto y = e1.y;
+    const auto e_min_x = std::min(e1.x, e2.x);
+    const auto e_max_x = std::max(e1.x, e2.x);
+
+    const bool y_inside  = (r.min_y < y && y < r.max_y);
+    const bool x_overlap = !(e_max_x <= r.min_x || e_min_x >= r.max_x);
+    return y_inside && x_overlap;
+}
+
+}  // namespace day09
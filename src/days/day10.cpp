@@ -1,10 +1,12 @@
-#include "aoc.hpp"
+#include "day10.hpp"
+
+#include "aoc/day.hpp"
+#include "aoc/parallel.hpp"
 
 #include <cstdlib>   // std::exit
 #include <iostream>
 
 #include <bit>
-#include <charconv>
 #include <cstdint>
 #include <stdexcept>
 #include <string>
@@ -15,22 +17,7 @@
 
 using namespace aoc;
 
-static std::string day_input_path(int argc, char **argv) {
-    if (argc > 1) {
-        return argv[1];  // allow custom path
-    }
-    return "../input/day10.txt";
-}
-
-using Pattern = std::vector<std::uint16_t>;
-using Groups  = std::vector<std::vector<std::uint16_t>>;
-using Values  = std::vector<std::uint16_t>;
-
-struct Row {
-    Pattern pattern;      // from [...]
-    Groups  groups;       // from each (...)
-    Values  values;       // from {...}
-};
+namespace day10 {
 
 std::ostream& operator<<(std::ostream& os, const Row& row) {
     os << "pattern: [";
@@ -69,24 +56,6 @@ std::ostream& operator<<(std::ostream& os, const Row& row) {
     return os;
 }
 
-// single 16-bit parser used everywhere
-std::uint16_t parse_u16(std::string_view sv) {
-    sv = trim(sv);
-    if (sv.empty()) {
-        throw std::runtime_error("empty integer field");
-    }
-
-    unsigned int tmp{};
-    auto [ptr, ec] = std::from_chars(sv.data(), sv.data() + sv.size(), tmp);
-    if (ec != std::errc{} || ptr != sv.data() + sv.size()) {
-        throw std::runtime_error("invalid integer: " + std::string(sv));
-    }
-    if (tmp > 65535u) {
-        throw std::runtime_error("integer out of uint16 range: " + std::to_string(tmp));
-    }
-    return static_cast<std::uint16_t>(tmp);
-}
-
 Pattern parse_pattern(std::string_view line) {
     auto open  = line.find('[');
     auto close = line.find(']', open == std::string_view::npos ? 0 : open + 1);
@@ -113,50 +82,47 @@ Pattern parse_pattern(std::string_view line) {
     return pattern;
 }
 
-Groups parse_groups(std::string_view line) {
+Groups parse_groups(std::string_view line, DelimiterOffsets &offsets) {
     Groups groups;
 
-    // stop at first '{', groups are before that
+    // groups sit between the ']' of the pattern and the first '{'
+    auto bracket_pos = line.find(']');
     auto brace_pos = line.find('{');
-    std::string_view section = (brace_pos == std::string_view::npos)
-                               ? line
-                               : line.substr(0, brace_pos);
-
-    std::size_t pos = 0;
-    while (pos < section.size()) {
-        auto open = section.find('(', pos);
-        if (open == std::string_view::npos) {
-            break;
-        }
-        auto close = section.find(')', open + 1);
-        if (close == std::string_view::npos) {
-            throw std::runtime_error("unmatched '(' in line: " + std::string(line));
-        }
+    std::size_t from = (bracket_pos == std::string_view::npos) ? 0 : bracket_pos + 1;
+    std::size_t to = (brace_pos == std::string_view::npos) ? line.size() : brace_pos;
+    std::string_view section = line.substr(from, to > from ? to - from : 0);
+
+    // Tokens between spaces and commas look like "(3", "4", "5)" or "(2)"
+    scan_delimiters(section, space | comma, offsets);
 
-        std::string_view inside = section.substr(open + 1, close - open - 1);
-        inside = trim(inside);
-
-        std::vector<std::uint16_t> group;
-        if (!inside.empty()) {
-            std::size_t ipos = 0;
-            while (ipos < inside.size()) {
-                auto comma = inside.find(',', ipos);
-                std::string_view tok = (comma == std::string_view::npos)
-                                       ? inside.substr(ipos)
-                                       : inside.substr(ipos, comma - ipos);
-                tok = trim(tok);
-                if (!tok.empty()) {
-                    group.push_back(parse_u16(tok));
-                }
-                if (comma == std::string_view::npos) {
-                    break;
-                }
-                ipos = comma + 1;
+    bool open = false;
+    for_each_field(section, offsets.fields, [&](std::string_view tok) {
+        if (tok.empty()) {
+            return;
+        }
+        if (tok.front() == '(') {
+            if (open) {
+                throw std::runtime_error("nested '(' in line: " + std::string(line));
             }
+            groups.emplace_back();
+            open = true;
+            tok.remove_prefix(1);
+        }
+        if (!open) {
+            throw std::runtime_error("value outside group in line: " + std::string(line));
+        }
+        const bool closes = !tok.empty() && tok.back() == ')';
+        if (closes) {
+            tok.remove_suffix(1);
+        }
+        if (!tok.empty()) {
+            groups.back().push_back(parse<std::uint16_t>(tok));
         }
+        open = !closes;
+    });
 
-        groups.push_back(std::move(group));
-        pos = close + 1;
+    if (open) {
+        throw std::runtime_error("unmatched '(' in line: " + std::string(line));
     }
 
     return groups;
@@ -169,40 +135,44 @@ Values parse_braced_values(std::string_view line) {
         throw std::runtime_error("invalid brace segment in line: " + std::string(line));
     }
 
-    std::string_view inside = line.substr(open + 1, close - open - 1);
+    Scanner sc{line.substr(open + 1, close - open - 1)};
     Values values;
 
-    std::size_t pos = 0;
-    while (pos < inside.size()) {
-        std::size_t comma = inside.find(',', pos);
-        std::string_view token = (comma == std::string_view::npos)
-                                 ? inside.substr(pos)
-                                 : inside.substr(pos, comma - pos);
-        token = trim(token);
-        if (!token.empty()) {
-            values.push_back(parse_u16(token));
-        }
-        if (comma == std::string_view::npos) {
-            break;
+    for (sc.skip_spaces(); !sc.done(); sc.skip_spaces()) {
+        values.push_back(sc.next<std::uint16_t>());
+        sc.skip_spaces();
+        if (!sc.done()) {
+            sc.expect(',');
         }
-        pos = comma + 1;
     }
 
     return values;
 }
 
-Row parse_line(const std::string& line_str) {
-    std::string_view line{line_str};
-
+Row parse_line(std::string_view line, DelimiterOffsets &offsets) {
     Row row;
     row.pattern = parse_pattern(line);
-    row.groups  = parse_groups(line);
+    row.groups  = parse_groups(line, offsets);
     row.values  = parse_braced_values(line);
 
     return row;
 }
 
-// Return how many groups are used by this mask if it matches pattern via XOR, -1 otherwise
+Rows parse_rows(Lines lines) {
+    Rows rows;
+    rows.reserve(lines.size());
+    DelimiterOffsets offsets;
+
+    for (const auto& line : lines) {
+        if (line.empty()) {
+            continue;
+        }
+        rows.push_back(parse_line(line, offsets));
+    }
+
+    return rows;
+}
+
 int used_groups_if_matches(const Groups& groups,
                            const Pattern& pattern,
                            std::uint64_t mask)
@@ -274,15 +244,10 @@ int min_groups_to_match(const Groups& groups,
     return best;
 }
 
-long long solve_part1(const std::vector<std::string> &lines) {
-    long long acc{0};
-
-    for (const auto& line : lines) {
-        if (line.empty()) {
-            continue;
-        }
-
-        Row row = parse_line(line);
+long long solve_part1(const Rows &rows) {
+    // Rows are independent; each one is a brute-force search over group subsets
+    return parallel_sum<long long>(0, rows.size(), [&](std::size_t r) {
+        const auto& row = rows[r];
         // std::cout << row << "\n";
 
         const auto& groups  = row.groups;
@@ -292,13 +257,11 @@ long long solve_part1(const std::vector<std::string> &lines) {
 
         if (best == -1) {
             // std::cout << "No matching combination for this row\n";
-        } else {
-            // std::cout << "Minimal groups to match: " << best << "\n";
-            acc += best;
+            return 0LL;
         }
-    }
-
-    return acc;
+        // std::cout << "Minimal groups to match: " << best << "\n";
+        return static_cast<long long>(best);
+    });
 }
 
 void dfs_presses(const Groups& groups,
@@ -398,16 +361,11 @@ int min_presses_to_match_values(const Groups& groups,
     return best;
 }
 
-long long solve_part2(const std::vector<std::string> &lines) {
+long long solve_part2(const Rows &rows) {
     long long acc{0};
 
-    for (const auto& line : lines) {
-        if (line.empty()) {
-            continue;
-        }
-
-        Row row = parse_line(line);
-        std::cout << row << "\n";
+    for (const auto& row : rows) {
+        AOC_LOG(debug, row);
 
         const auto& groups = row.groups;
         const auto& target = row.values;  // part 2 uses values as target
@@ -415,11 +373,11 @@ long long solve_part2(const std::vector<std::string> &lines) {
         int best = min_presses_to_match_values(groups, target);
 
         if (best == -1) {
-            std::cout << "No matching combination (within heuristic) for this row\n";
+            AOC_LOG(warn, "No matching combination (within heuristic) for this row");
             // Depending on what you want:
             // either ignore, or throw, or treat as large cost.
         } else {
-            std::cout << "Minimal presses for values: " << best << "\n";
+            AOC_LOG(debug, "Minimal presses for values: ", best);
             acc += best;
         }
     }
@@ -427,24 +385,13 @@ long long solve_part2(const std::vector<std::string> &lines) {
     return acc;
 }
 
-int main(int argc, char **argv) {
-    try {
-        const auto input_path = day_input_path(argc, argv);
-        auto lines = read_lines(input_path);
-
-        {
-            auto [ans1, t1] = time_it([&] { return solve_part1(lines); });
-            print_answer(1, ans1, t1);
-        }
+struct Day10 {
+    using Model = Rows;
+    static Model parse(Lines lines) { return parse_rows(lines); }
+    static long long part1(const Model &rows) { return solve_part1(rows); }
+    static long long part2(const Model &rows) { return solve_part2(rows); }
+};
 
-        {
-            auto [ans2, t2] = time_it([&] { return solve_part2(lines); });
-            print_answer(2, ans2, t2);
-        }
+}  // namespace day10
 
-    } catch (const std::exception &e) {
-        std::cerr << "Error: " << e.what() << "\n";
-        return EXIT_FAILURE;
-    }
-    return EXIT_SUCCESS;
-}
\ No newline at end of file
+AOC_REGISTER_DAY(10, day10::Day10, "input/day10.txt")
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "aoc.hpp"
+
+#include <cstdint>
+#include <vector>
+
+// Day 10 kernels, shared with aoc_bench.
+namespace day10 {
+
+using Pattern = std::vector<std::uint16_t>;
+using Groups  = std::vector<std::vector<std::uint16_t>>;
+using Values  = std::vector<std::uint16_t>;
+
+struct Row {
+    Pattern pattern;      // from [...]
+    Groups  groups;       // from each (...)
+    Values  values;       // from {...}
+};
+
+using Rows = std::vector<Row>;
+
+Rows parse_rows(aoc::Lines lines);
+
+// Return how many groups are used by this mask if it matches pattern via XOR, -1 otherwise
+int used_groups_if_matches(const Groups& groups,
+                           const Pattern& pattern,
+                           std::uint64_t mask);
+
+}  // namespace day10
@@ -1,104 +1,74 @@
-#include "aoc.hpp"
+#include "day11.hpp"
 
+#include "aoc/day.hpp"
+
+#include <cctype>
 #include <cstdlib>   // std::exit
 #include <iostream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <algorithm>
+#include <vector>
 
 using namespace aoc;
 
-static std::string day_input_path(int argc, char **argv) {
-    if (argc > 1) {
-        return argv[1];  // allow custom path
-    }
-    return "../input/day11.txt";
-}
-
-#include <string>
-#include <string_view>
-#include <vector>
-#include <stdexcept>
-#include <cctype>
+namespace day11 {
 
 struct ParsedLine {
     std::string parent;                 // the 3 chars before ':'
     std::vector<std::string> child_l;    // list of 3-char tokens after ':'
 };
 
-void print_line_input(ParsedLine entry) {
-    std::cout << "node = " << entry.parent << "\n";
-    std::cout << "child:\n";
-    for (auto& t : entry.child_l) {
-        std::cout << "  " << t << "\n";
+void log_line_input(const ParsedLine &entry) {
+    AOC_LOG(trace, "node = ", entry.parent);
+    for (const auto &t : entry.child_l) {
+        AOC_LOG(trace, "  child ", t);
     }
 }
 
-ParsedLine parse_line(std::string_view line) {
-    // Find the colon
-    auto colon_pos = line.find(':');
-    if (colon_pos == std::string_view::npos) {
+ParsedLine parse_line(std::string_view line, DelimiterOffsets &offsets) {
+    // One pass finds the ':' and every space separating the children
+    scan_delimiters(line, colon | space, offsets);
+    const auto &cuts = offsets.fields;
+
+    if (cuts.empty() || line[cuts.front()] != ':') {
         throw std::runtime_error("line missing ':'");
     }
-    if (colon_pos != 3) {
-        throw std::runtime_error("expected exactly 3 chars before ':'");
+    if (cuts.front() == 0) {
+        throw std::runtime_error("missing device name before ':'");
     }
 
+    // Real inputs use three-letter names; generated ones may be longer
     ParsedLine result;
-    result.parent = std::string(line.substr(0, 3));
-
-    // Part after ':'
-    std::string_view rest = line.substr(colon_pos + 1);
-
-    // Trim leading spaces
-    auto is_space = [](unsigned char c) { return std::isspace(c) != 0; };
-
-    auto l = rest.begin();
-    auto r = rest.end();
-    while (l != r && is_space(static_cast<unsigned char>(*l))) {
-        ++l;
-    }
-    while (r != l && is_space(static_cast<unsigned char>(*(r - 1)))) {
-        --r;
-    }
-    rest = std::string_view(l, static_cast<std::size_t>(r - l));
-
-    // Split by spaces into tokens
-    std::size_t pos = 0;
-    while (pos < rest.size()) {
-        // find next space
-        auto space_pos = rest.find(' ', pos);
-        std::string_view token = (space_pos == std::string_view::npos)
-                               ? rest.substr(pos)
-                               : rest.substr(pos, space_pos - pos);
-
-        if (!token.empty()) {
-            if (token.size() != 3) {
-                throw std::runtime_error("child_l token not 3 chars: '" + std::string(token) + "'");
-            }
-            result.child_l.emplace_back(token);
+    result.parent = std::string(line.substr(0, cuts.front()));
+
+    // Part after ':', split by spaces into tokens
+    std::size_t start = cuts.front() + 1;
+    for (std::size_t k = 1; k <= cuts.size(); ++k) {
+        const std::size_t end = k < cuts.size() ? cuts[k] : line.size();
+        if (end < line.size() && line[end] != ' ') {
+            throw std::runtime_error("unexpected ':' after parent: " + std::string(line));
         }
+        std::string_view token = line.substr(start, end - start);
+        start = end + 1;
 
-        if (space_pos == std::string_view::npos) {
-            break;
+        if (token.empty()) {
+            continue;
         }
-        pos = space_pos + 1;
+        result.child_l.emplace_back(token);
     }
 
     return result;
 }
 
-struct Node {
-    std::vector<std::string> child_l;
-};
-
-using Graph = std::unordered_map<std::string, Node>;
-
-Graph build_graph(const std::vector<std::string> &lines) {
+Graph build_graph(Lines lines) {
     Graph g;
+    DelimiterOffsets offsets;
     for (const auto &line : lines) {
-        auto entry = parse_line(line);
+        auto entry = parse_line(line, offsets);
 
         Node& node = g[entry.parent];  // creates or gets the Node in place
         node.child_l = std::move(entry.child_l);
@@ -121,20 +91,10 @@ long long find_paths(const Graph &g, const std::string &parent, long long count)
     return count;
 }
 
-long long solve_part1(const std::vector<std::string> &lines) {
-    Graph g = build_graph(lines);
-
+long long solve_part1(const Graph &g) {
     return find_paths(g, "you", 0);
 }
 
-using Mask = std::uint8_t;
-
-struct DfsContext {
-    const Graph& g;
-    std::unordered_map<std::string, int> target_index;  // name -> bit
-    std::unordered_map<std::string, std::unordered_map<Mask, long long>> memo;
-};
-
 // DFS
 // Assume its a DAG - direct acyclic graph
 [[nodiscard]]
@@ -156,7 +116,7 @@ long long find_problematic_paths(DfsContext& ctx,
     // If parent is one of the targets, clear its bit
     if (auto it = ctx.target_index.find(parent); it != ctx.target_index.end()) {
         int bit = it->second;
-        remaining &= ~(Mask(1) << bit);
+        remaining = static_cast<Mask>(remaining & ~(Mask(1) << bit));
     }
 
     auto git = ctx.g.find(parent);
@@ -174,9 +134,7 @@ long long find_problematic_paths(DfsContext& ctx,
     return count;
 }
 
-long long solve_part2(const std::vector<std::string> &lines) {
-    Graph g = build_graph(lines);
-
+long long solve_part2(const Graph &g) {
     std::vector<std::string> targets{"dac", "fft"};
 
     DfsContext ctx{g, {}, {}};
@@ -191,24 +149,13 @@ long long solve_part2(const std::vector<std::string> &lines) {
     return find_problematic_paths(ctx, "svr", initial_mask);
 }
 
-int main(int argc, char **argv) {
-    try {
-        const auto input_path = day_input_path(argc, argv);
-        auto lines = read_lines(input_path);
-
-        // {
-        //     auto [ans1, t1] = time_it([&] { return solve_part1(lines); });
-        //     print_answer(1, ans1, t1);
-        // }
+struct Day11 {
+    using Model = Graph;
+    static Model parse(Lines lines) { return build_graph(lines); }
+    static long long part1(const Model &g) { return solve_part1(g); }
+    static long long part2(const Model &g) { return solve_part2(g); }
+};
 
-        {
-            auto [ans2, t2] = time_it([&] { return solve_part2(lines); });
-            print_answer(2, ans2, t2);
-        }
+}  // namespace day11
 
-    } catch (const std::exception &e) {
-        std::cerr << "Error: " << e.what() << "\n";
-        return EXIT_FAILURE;
-    }
-    return EXIT_SUCCESS;
-}
\ No newline at end of file
+AOC_REGISTER_DAY(11, day11::Day11, "input/day11.txt")
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "aoc.hpp"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Day 11 kernels, shared with aoc_bench.
+namespace day11 {
+
+struct Node {
+    std::vector<std::string> child_l;
+};
+
+using Graph = std::unordered_map<std::string, Node>;
+
+Graph build_graph(aoc::Lines lines);
+
+using Mask = std::uint8_t;
+
+struct DfsContext {
+    const Graph& g;
+    std::unordered_map<std::string, int> target_index;  // name -> bit
+    std::unordered_map<std::string, std::unordered_map<Mask, long long>> memo;
+};
+
+// Paths from parent to "out" that pass every target still set in remaining.
+long long find_problematic_paths(DfsContext& ctx,
+                                 const std::string& parent,
+                                 Mask remaining);
+
+}  // namespace day11
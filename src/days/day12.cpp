@@ -1,48 +1,18 @@
-#include "aoc.hpp"
+#include "aoc/day.hpp"
 
 #include <cstddef>
 #include <cstdlib>   // std::exit
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <string_view>
 #include <vector>
 #include <array>
-#include <charconv>
 #include <stdexcept>
-#include <cctype>
 
 using namespace aoc;
 
-static std::string day_input_path(int argc, char **argv) {
-    if (argc > 1) {
-        return argv[1];  // allow custom path
-    }
-    return "../input/day12.txt";
-}
-
-// ---------- small helpers ----------
-
-static std::string_view trim_sv(std::string_view sv) {
-    auto is_space = [](unsigned char c) { return std::isspace(c) != 0; };
-
-    while (!sv.empty() && is_space(static_cast<unsigned char>(sv.front()))) {
-        sv.remove_prefix(1);
-    }
-    while (!sv.empty() && is_space(static_cast<unsigned char>(sv.back()))) {
-        sv.remove_suffix(1);
-    }
-    return sv;
-}
-
-static int parse_int(std::string_view sv) {
-    sv = trim_sv(sv);
-    int value{};
-    auto [ptr, ec] = std::from_chars(sv.data(), sv.data() + sv.size(), value);
-    if (ec != std::errc{} || ptr != sv.data() + sv.size()) {
-        throw std::runtime_error("invalid integer: '" + std::string(sv) + "'");
-    }
-    return value;
-}
+namespace day12 {
 
 // ---------- data structures ----------
 
@@ -70,7 +40,7 @@ struct RegionSpec {
 // Parse all present definitions at the top of the file.
 // Returns the vector of presents and sets 'region_start' to the index
 // in 'lines' where the first region line appears.
-static Presents parse_presents(const std::vector<std::string>& lines,
+static Presents parse_presents(Lines lines,
                                std::size_t& region_start) {
     Presents presents;
     std::size_t i = 0;
@@ -94,7 +64,7 @@ static Presents parse_presents(const std::vector<std::string>& lines,
         // Expect present header like "0:" or "1:"
         auto colon_pos = sv.find(':');
         if (colon_pos == std::string_view::npos) {
-            throw std::runtime_error("expected present header with ':', got: " + lines[i]);
+            throw std::runtime_error("expected present header with ':', got: " + std::string(lines[i]));
         }
 
         // Next 3 non-empty lines are the 3×3 grid
@@ -110,7 +80,7 @@ static Presents parse_presents(const std::vector<std::string>& lines,
                 continue; // skip blank lines between presents
             }
             if (lines[i].size() != 3) {
-                throw std::runtime_error("present grid row must be length 3: " + lines[i]);
+                throw std::runtime_error("present grid row must be length 3: " + std::string(lines[i]));
             }
 
             for (size_t col{0}; col < 3; ++col) {
@@ -138,71 +108,53 @@ static Presents parse_presents(const std::vector<std::string>& lines,
     return presents;
 }
 
-void print_points(const std::vector<Point>& pts) {
-    std::cout << "points: ";
+std::string format_points(const std::vector<Point>& pts) {
+    std::ostringstream os;
+    os << "points: ";
     if (pts.empty()) {
-        std::cout << "(none)\n";
-        return;
+        os << "(none)";
+        return os.str();
     }
 
     bool first = true;
     for (const auto& [r, c] : pts) {
-        if (!first) std::cout << " ";
+        if (!first) os << " ";
         first = false;
-        std::cout << "("
-                  << static_cast<int>(r) << ","
-                  << static_cast<int>(c) << ")";
+        os << "("
+           << static_cast<int>(r) << ","
+           << static_cast<int>(c) << ")";
     }
-    std::cout << "\n";
+    return os.str();
 }
 
 static RegionSpec parse_region_line(std::string_view line,
                                     std::size_t num_presents) {
-    line = trim_sv(line);
+    line = trim(line);
     if (line.empty()) {
         throw std::runtime_error("empty region line");
     }
 
-    auto colon_pos = line.find(':');
-    if (colon_pos == std::string_view::npos) {
-        throw std::runtime_error("region line missing ':' : " + std::string(line));
+    // line like "12x5: 0 0 0 0 2 0" -> dims, then num_presents integers
+    Scanner sc{line};
+    int width  = sc.next<int>();
+    sc.skip_spaces();
+    if (!sc.consume('x')) {
+        throw std::runtime_error("invalid region dims (missing 'x'): " + std::string(line));
     }
-
-    std::string_view dim_part = trim_sv(line.substr(0, colon_pos));
-    std::string_view rest     = trim_sv(line.substr(colon_pos + 1));
-
-    // dim_part like "4x4" or "12x5"
-    auto x_pos = dim_part.find('x');
-    if (x_pos == std::string_view::npos) {
-        throw std::runtime_error("invalid region dims (missing 'x'): " + std::string(dim_part));
+    int height = sc.next<int>();
+    sc.skip_spaces();
+    if (!sc.consume(':')) {
+        throw std::runtime_error("region line missing ':' : " + std::string(line));
     }
-
-    int width  = parse_int(dim_part.substr(0, x_pos));
-    int height = parse_int(dim_part.substr(x_pos + 1));
     int number_presents{0};
 
-    // rest: "0 0 0 0 2 0" -> num_presents integers
     std::vector<int> counts;
     counts.reserve(num_presents);
 
-    std::size_t pos = 0;
-    while (pos < rest.size() && counts.size() < num_presents) {
-        // skip spaces
-        while (pos < rest.size() && std::isspace(static_cast<unsigned char>(rest[pos]))) {
-            ++pos;
-        }
-        if (pos >= rest.size()) {
-            break;
-        }
-
-        std::size_t start = pos;
-        while (pos < rest.size() && !std::isspace(static_cast<unsigned char>(rest[pos]))) {
-            ++pos;
-        }
-
-        std::string_view tok = rest.substr(start, pos - start);
-        number_presents += parse_int(tok);
-        counts.push_back(parse_int(tok));
+    for (sc.skip_spaces(); !sc.done() && counts.size() < num_presents; sc.skip_spaces()) {
+        const int count = sc.next<int>();
+        number_presents += count;
+        counts.push_back(count);
     }
 
     if (counts.size() != num_presents) {
@@ -212,50 +164,67 @@ static RegionSpec parse_region_line(std::string_view line,
     return RegionSpec{width, height, std::move(counts), number_presents};
 }
 
-void print_presents(const Presents& presents) {
-    std::cout << "Presents (" << presents.size() << "):\n";
+std::string format_presents(const Presents& presents) {
+    std::ostringstream os;
+    os << "Presents (" << presents.size() << "):\n";
     for (std::size_t i = 0; i < presents.size(); ++i) {
-        std::cout << "Present " << i << ":\n";
-        // Print list of points
-        print_points(presents[i].points);
+        os << "Present " << i << ":\n";
+        // List of points, then the shape
+        os << format_points(presents[i].points) << "\n";
         const auto& grid = presents[i].grid;
         for (size_t r{0}; r < 3; ++r) {
             for (size_t c{0}; c < 3; ++c) {
-                std::cout << (grid[r][c] ? '#' : '.');
+                os << (grid[r][c] ? '#' : '.');
             }
-            std::cout << "\n";
+            os << "\n";
         }
-        std::cout << "\n";
     }
+    return os.str();
 }
 
-void print_region(const RegionSpec& r) {
-    std::cout << "Region " << r.width << "x" << r.height << "  counts: ";
+std::string format_region(const RegionSpec& r) {
+    std::ostringstream os;
+    os << "Region " << r.width << "x" << r.height << "  counts: ";
     for (std::size_t i = 0; i < r.counts.size(); ++i) {
-        std::cout << r.counts[i];
+        os << r.counts[i];
         if (i + 1 < r.counts.size()) {
-            std::cout << " ";
+            os << " ";
         }
     }
-    std::cout << "\n";
+    return os.str();
 }
 
-// ---------- AoC logic ----------
+struct Farm {
+    Presents presents;
+    std::vector<RegionSpec> regions;
+};
 
-long long solve_part1(const std::vector<std::string> &lines) {
+// Parse the present definitions followed by the region lines.
+static Farm parse_farm(Lines lines) {
+    Farm farm;
     std::size_t region_start{0};
-    Presents presents = parse_presents(lines, region_start);
-
-    // print_presents(presents);
-
-    long long acc{0};
+    farm.presents = parse_presents(lines, region_start);
 
     for (std::size_t i = region_start; i < lines.size(); ++i) {
         if (lines[i].empty()) {
             continue;
         }
-        RegionSpec r = parse_region_line(lines[i], presents.size());
+        farm.regions.push_back(parse_region_line(lines[i], farm.presents.size()));
+    }
+
+    return farm;
+}
+
+// ---------- AoC logic ----------
+
+long long solve_part1(const Farm &farm) {
+    const Presents &presents = farm.presents;
+
+    AOC_LOG(trace, format_presents(presents));
 
+    long long acc{0};
+
+    for (const RegionSpec &r : farm.regions) {
         // The area of the presents need to fit in the area
         long long area_grid{r.height * r.width};
         long long area_presents{0};
@@ -270,7 +239,7 @@ long long solve_part1(const std::vector<std::string> &lines) {
 
         // if (disjoint_boxes < r.number_presents) continue;
 
-        // print_region(r);
+        AOC_LOG(trace, format_region(r));
 
         ++acc;
     }
@@ -278,19 +247,12 @@ long long solve_part1(const std::vector<std::string> &lines) {
     return acc;
 }
 
-int main(int argc, char **argv) {
-    try {
-        const auto input_path = day_input_path(argc, argv);
-        auto lines = read_lines(input_path);
+struct Day12 {
+    using Model = Farm;
+    static Model parse(Lines lines) { return parse_farm(lines); }
+    static long long part1(const Model &farm) { return solve_part1(farm); }
+};
 
-        {
-            auto [ans1, t1] = time_it([&] { return solve_part1(lines); });
-            print_answer(1, ans1, t1);
-        }
+}  // namespace day12
 
-    } catch (const std::exception &e) {
-        std::cerr << "Error: " << e.what() << "\n";
-        return EXIT_FAILURE;
-    }
-    return EXIT_SUCCESS;
-}
\ No newline at end of file
+AOC_REGISTER_DAY(12, day12::Day12, "input/day12.txt")
@@ -1,53 +1,44 @@
-#include "aoc.hpp"
+#include "aoc/day.hpp"
 
-#include <cstdlib>   // std::exit
-#include <iostream>
-#include <string>
+#include <string_view>
+#include <vector>
 
 using namespace aoc;
 
-static std::string day_input_path(int argc, char **argv) {
-    if (argc > 1) {
-        return argv[1];  // allow custom path
-    }
-    return "../input/dayXX.txt";
+namespace dayXX {
+
+using Entries = std::vector<std::string_view>;
+
+Entries parse_input(Lines lines) {
+    // placeholder: keep the raw lines; replace with the day's parsed structure
+    return {lines.begin(), lines.end()};
 }
 
-long long solve_part1(const std::vector<std::string> &lines) {
+long long solve_part1(const Entries &model) {
     long long acc{0};
-    for (const auto &line : lines) {
+    for (const auto &line : model) {
         // dummy logic as placeholder
         acc += static_cast<long long>(line.size());
     }
     return acc;
 }
 
-long long solve_part2(const std::vector<std::string> &lines) {
+long long solve_part2(const Entries &model) {
     long long acc{0};
-    for (const auto &line : lines) {
+    for (const auto &line : model) {
         acc += static_cast<long long>(line.size()) * 2;
     }
     return acc;
 }
 
-int main(int argc, char **argv) {
-    try {
-        const auto input_path = day_input_path(argc, argv);
-        auto lines = read_lines(input_path);
+struct DayXX {
+    using Model = Entries;
+    static Model parse(Lines lines) { return parse_input(lines); }
+    static long long part1(const Model &model) { return solve_part1(model); }
+    static long long part2(const Model &model) { return solve_part2(model); }
+};
 
-        {
-            auto [ans1, t1] = time_it([&] { return solve_part1(lines); });
-            print_answer(1, ans1, t1);
-        }
+}  // namespace dayXX
 
-        {
-            auto [ans2, t2] = time_it([&] { return solve_part2(lines); });
-            print_answer(2, ans2, t2);
-        }
-
-    } catch (const std::exception &e) {
-        std::cerr << "Error: " << e.what() << "\n";
-        return EXIT_FAILURE;
-    }
-    return EXIT_SUCCESS;
-}
\ No newline at end of file
+// Replace 0 with the day number; the registry rejects duplicates.
+AOC_REGISTER_DAY(0, dayXX::DayXX, "input/dayXX.txt")
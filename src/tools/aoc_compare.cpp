@@ -0,0 +1,455 @@
+// Compare two result files written with --format=json or --format=csv and
+// flag per-stage slowdowns that are statistically significant.
+//
+//   aoc_compare baseline.json candidate.json [--alpha=0.01] [--threshold=0.05]
+//
+// A stage counts as slower when Welch's one-sided t-test on the benchmark
+// mean/stddev/runs gives p < alpha AND the mean grew by more than
+// `threshold` (relative). Files need --bench runs for the test; single runs
+// are listed but never flagged. Rows are paired by day, stage and input
+// (its content hash, or its name when there is none), so batch reports
+// compare file by file; a row found on one side only is listed as added or
+// removed. Exit status: 0 clean, 1 slowdown or changed answer, 2 usage or
+// parse error.
+
+#include "aoc.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Record = std::map<std::string, std::optional<std::string>, std::less<>>;
+
+// ---------- reading ----------
+
+// Just enough JSON for what write_report produces: an array of flat objects
+// whose values are strings, numbers, booleans or null.
+class JsonReader {
+public:
+    explicit JsonReader(std::string_view text) : text_(text) {}
+
+    std::vector<Record> read_records() {
+        std::vector<Record> records;
+        expect('[');
+        if (peek() == ']') {
+            ++pos_;
+            return records;
+        }
+        while (true) {
+            records.push_back(read_object());
+            if (peek() == ',') {
+                ++pos_;
+                continue;
+            }
+            expect(']');
+            return records;
+        }
+    }
+
+private:
+    Record read_object() {
+        Record record;
+        expect('{');
+        if (peek() == '}') {
+            ++pos_;
+            return record;
+        }
+        while (true) {
+            std::string key = read_string();
+            expect(':');
+            record[std::move(key)] = read_value();
+            if (peek() == ',') {
+                ++pos_;
+                continue;
+            }
+            expect('}');
+            return record;
+        }
+    }
+
+    std::optional<std::string> read_value() {
+        const char c = peek();
+        if (c == '"') {
+            return read_string();
+        }
+        if (text_.substr(pos_).starts_with("null")) {
+            pos_ += 4;
+            return std::nullopt;
+        }
+        const std::size_t start = pos_;
+        while (pos_ < text_.size() && std::string_view{"+-.0123456789eEtruefals"}.find(text_[pos_]) != std::string_view::npos) {
+            ++pos_;
+        }
+        if (start == pos_) {
+            fail("value");
+        }
+        return std::string(text_.substr(start, pos_ - start));
+    }
+
+    std::string read_string() {
+        expect('"');
+        std::string out;
+        while (pos_ < text_.size() && text_[pos_] != '"') {
+            char c = text_[pos_++];
+            if (c == '\\' && pos_ < text_.size()) {
+                const char esc = text_[pos_++];
+                switch (esc) {
+                    case 'n': c = '\n'; break;
+                    case 't': c = '\t'; break;
+                    case 'u':
+                        c = static_cast<char>(std::stoi(std::string(text_.substr(pos_, 4)), nullptr, 16));
+                        pos_ += 4;
+                        break;
+                    default: c = esc;
+                }
+            }
+            out.push_back(c);
+        }
+        expect('"');
+        return out;
+    }
+
+    char peek() {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+            ++pos_;
+        }
+        return pos_ < text_.size() ? text_[pos_] : '\0';
+    }
+
+    void expect(char c) {
+        if (peek() != c) {
+            fail(std::string("'") + c + "'");
+        }
+        ++pos_;
+    }
+
+    [[noreturn]] void fail(const std::string &what) const {
+        throw std::runtime_error("JSON: expected " + what + " at offset " + std::to_string(pos_));
+    }
+
+    std::string_view text_;
+    std::size_t pos_{0};
+};
+
+std::vector<std::string> split_csv_line(std::string_view line) {
+    std::vector<std::string> cells(1);
+    bool quoted = false;
+    for (std::size_t i = 0; i < line.size(); ++i) {
+        const char c = line[i];
+        if (quoted) {
+            if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+                cells.back().push_back('"');
+                ++i;
+            } else if (c == '"') {
+                quoted = false;
+            } else {
+                cells.back().push_back(c);
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',') {
+            cells.emplace_back();
+        } else {
+            cells.back().push_back(c);
+        }
+    }
+    return cells;
+}
+
+std::vector<Record> read_csv(const aoc::MappedInput &input) {
+    const auto lines = input.lines();
+    if (lines.empty()) {
+        return {};
+    }
+    const auto header = split_csv_line(lines[0]);
+    std::vector<Record> records;
+    for (std::size_t l = 1; l < lines.size(); ++l) {
+        if (lines[l].empty()) {
+            continue;
+        }
+        const auto cells = split_csv_line(lines[l]);
+        if (cells.size() != header.size()) {
+            throw std::runtime_error("CSV line " + std::to_string(l + 1) + " has " + std::to_string(cells.size()) +
+                                     " cells, header has " + std::to_string(header.size()));
+        }
+        Record record;
+        for (std::size_t c = 0; c < header.size(); ++c) {
+            record[header[c]] = cells[c].empty() ? std::nullopt : std::optional{cells[c]};
+        }
+        records.push_back(std::move(record));
+    }
+    return records;
+}
+
+std::vector<Record> read_results(const std::string &path) {
+    aoc::MappedInput input(path);
+    const auto text = aoc::trim(input.text());
+    if (text.starts_with('[')) {
+        return JsonReader(text).read_records();
+    }
+    return read_csv(input);
+}
+
+// ---------- statistics ----------
+
+// Continued fraction for the regularized incomplete beta function.
+double beta_continued_fraction(double a, double b, double x) {
+    constexpr int max_iterations = 300;
+    constexpr double eps = 1e-14;
+    constexpr double tiny = 1e-300;
+
+    double c = 1.0;
+    double d = 1.0 - (a + b) * x / (a + 1.0);
+    d = 1.0 / (std::abs(d) < tiny ? tiny : d);
+    double h = d;
+    for (int m = 1; m <= max_iterations; ++m) {
+        const double m2 = 2.0 * m;
+        double aa = m * (b - m) * x / ((a + m2 - 1.0) * (a + m2));
+        d = 1.0 + aa * d;
+        d = 1.0 / (std::abs(d) < tiny ? tiny : d);
+        c = 1.0 + aa / c;
+        c = std::abs(c) < tiny ? tiny : c;
+        h *= d * c;
+        aa = -(a + m) * (a + b + m) * x / ((a + m2) * (a + m2 + 1.0));
+        d = 1.0 + aa * d;
+        d = 1.0 / (std::abs(d) < tiny ? tiny : d);
+        c = 1.0 + aa / c;
+        c = std::abs(c) < tiny ? tiny : c;
+        const double delta = d * c;
+        h *= delta;
+        if (std::abs(delta - 1.0) < eps) {
+            break;
+        }
+    }
+    return h;
+}
+
+double incomplete_beta(double a, double b, double x) {
+    if (x <= 0.0) {
+        return 0.0;
+    }
+    if (x >= 1.0) {
+        return 1.0;
+    }
+    const double front = std::exp(std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) +
+                                  a * std::log(x) + b * std::log(1.0 - x));
+    if (x < (a + 1.0) / (a + b + 2.0)) {
+        return front * beta_continued_fraction(a, b, x) / a;
+    }
+    return 1.0 - front * beta_continued_fraction(b, a, 1.0 - x) / b;
+}
+
+// P(T > t) for Student's t with `df` degrees of freedom.
+double t_upper_tail(double t, double df) {
+    const double tail = 0.5 * incomplete_beta(df / 2.0, 0.5, df / (df + t * t));
+    return t > 0 ? tail : 1.0 - tail;
+}
+
+struct Sample {
+    double mean{0};
+    double stddev{0};
+    double runs{0};
+};
+
+struct Welch {
+    double p_slower{1.0};  // one-sided: candidate mean > baseline mean
+    double p_faster{1.0};
+};
+
+Welch welch_test(const Sample &base, const Sample &cand) {
+    const double vb = base.stddev * base.stddev / base.runs;
+    const double vc = cand.stddev * cand.stddev / cand.runs;
+    const double se2 = vb + vc;
+    if (se2 <= 0.0) {
+        // No spread at all: any difference is as significant as it gets.
+        const bool slower = cand.mean > base.mean;
+        const bool faster = cand.mean < base.mean;
+        return {slower ? 0.0 : 1.0, faster ? 0.0 : 1.0};
+    }
+    const double t = (cand.mean - base.mean) / std::sqrt(se2);
+    const double df = se2 * se2 / (vb * vb / (base.runs - 1.0) + vc * vc / (cand.runs - 1.0));
+    return {t_upper_tail(t, df), t_upper_tail(-t, df)};
+}
+
+// ---------- comparison ----------
+
+std::optional<double> number(const Record &r, std::string_view key) {
+    const auto it = r.find(key);
+    if (it == r.end() || !it->second) {
+        return std::nullopt;
+    }
+    return std::stod(*it->second);
+}
+
+std::string text(const Record &r, std::string_view key) {
+    const auto it = r.find(key);
+    return it == r.end() || !it->second ? std::string{} : *it->second;
+}
+
+// Mean/stddev/runs in ns; nullopt without at least two benchmark runs.
+std::optional<Sample> sample(const Record &r) {
+    const auto runs = number(r, "runs");
+    const auto mean = number(r, "mean_ns");
+    const auto stddev = number(r, "stddev_ns");
+    if (!runs || *runs < 2 || !mean || !stddev) {
+        return std::nullopt;
+    }
+    return Sample{*mean, *stddev, *runs};
+}
+
+// Which row of the other file a row is compared with. `occurrence` pairs up
+// repeated rows (the same input listed twice in a batch) in file order.
+struct RowKey {
+    int day{0};
+    std::string stage;
+    std::string input;
+    int occurrence{0};
+
+    auto operator<=>(const RowKey &) const = default;
+};
+
+std::vector<RowKey> row_keys(const std::vector<Record> &records) {
+    std::map<RowKey, int> seen;
+    std::vector<RowKey> keys;
+    keys.reserve(records.size());
+    for (const auto &r : records) {
+        RowKey key{static_cast<int>(number(r, "day").value_or(0)), text(r, "stage"), text(r, "input_hash"), 0};
+        if (key.input.empty()) {
+            key.input = text(r, "input");
+        }
+        key.occurrence = seen[key]++;
+        keys.push_back(std::move(key));
+    }
+    return keys;
+}
+
+double parse_fraction(std::string_view name, std::string_view value) {
+    try {
+        return std::stod(std::string(value));
+    } catch (const std::exception &) {
+        throw std::runtime_error("invalid value for " + std::string(name) + ": '" + std::string(value) + "'");
+    }
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    double alpha = 0.01;
+    double threshold = 0.05;
+    std::vector<std::string> paths;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view arg{argv[i]};
+            if (arg.starts_with("--alpha=")) {
+                alpha = parse_fraction("--alpha", arg.substr(8));
+            } else if (arg.starts_with("--threshold=")) {
+                threshold = parse_fraction("--threshold", arg.substr(12));
+            } else if (arg.starts_with("--")) {
+                throw std::runtime_error("unknown option: " + std::string(arg));
+            } else {
+                paths.emplace_back(arg);
+            }
+        }
+        if (paths.size() != 2) {
+            throw std::runtime_error("usage: aoc_compare BASELINE CANDIDATE [--alpha=P] [--threshold=FRACTION]");
+        }
+
+        const auto baseline = read_results(paths[0]);
+        const auto candidate = read_results(paths[1]);
+
+        const auto base_keys = row_keys(baseline);
+        const auto cand_keys = row_keys(candidate);
+        std::map<RowKey, const Record *> base_by_key;
+        for (std::size_t i = 0; i < baseline.size(); ++i) {
+            base_by_key[base_keys[i]] = &baseline[i];
+        }
+
+        std::cout << "Day  Stage   Baseline (ns)  Candidate (ns)    Change   p-value  Verdict  Input\n";
+        std::cout << std::fixed;
+
+        int slower{0};
+        int faster{0};
+        int changed{0};
+        int added{0};
+        std::set<RowKey> matched;
+        for (std::size_t i = 0; i < candidate.size(); ++i) {
+            const Record &cand = candidate[i];
+            const RowKey &key = cand_keys[i];
+            const int day = key.day;
+            const std::string &stage = key.stage;
+            const auto it = base_by_key.find(key);
+            if (it == base_by_key.end()) {
+                std::cout << std::setw(3) << day << "  " << std::left << std::setw(6) << stage << std::right
+                          << "  added: " << text(cand, "input") << "\n";
+                ++added;
+                continue;
+            }
+            matched.insert(key);
+            const Record &base = *it->second;
+
+            const auto bs = sample(base);
+            const auto cs = sample(cand);
+            const double base_ns = bs ? bs->mean : number(base, "micros").value_or(0) * 1000.0;
+            const double cand_ns = cs ? cs->mean : number(cand, "micros").value_or(0) * 1000.0;
+            const double change = base_ns > 0 ? cand_ns / base_ns - 1.0 : 0.0;
+
+            std::string verdict = "n/a (needs --bench)";
+            std::string p_text = "-";
+            if (bs && cs) {
+                const auto w = welch_test(*bs, *cs);
+                verdict = "same";
+                if (w.p_slower < alpha && change > threshold) {
+                    verdict = "SLOWER";
+                    ++slower;
+                } else if (w.p_faster < alpha && change < -threshold) {
+                    verdict = "faster";
+                    ++faster;
+                }
+                std::ostringstream p;
+                p << std::setprecision(4) << std::min(w.p_slower, w.p_faster);
+                p_text = p.str();
+            }
+            if (text(base, "answer") != text(cand, "answer")) {
+                verdict += " ANSWER CHANGED";
+                ++changed;
+            }
+
+            std::cout << std::setw(3) << day << "  " << std::left << std::setw(6) << stage << std::right
+                      << std::setprecision(0) << std::setw(15) << base_ns << std::setw(16) << cand_ns
+                      << std::setprecision(1) << std::showpos << std::setw(9) << change * 100.0 << "%"
+                      << std::noshowpos << std::setw(10) << p_text << "  " << verdict << "  " << text(cand, "input") << "\n";
+        }
+
+        int removed{0};
+        for (std::size_t i = 0; i < baseline.size(); ++i) {
+            if (!matched.contains(base_keys[i])) {
+                std::cout << std::setw(3) << base_keys[i].day << "  " << std::left << std::setw(6)
+                          << base_keys[i].stage << std::right << "  removed: " << text(baseline[i], "input") << "\n";
+                ++removed;
+            }
+        }
+
+        std::cout << slower << " slower, " << faster << " faster, " << changed << " changed answers, " << added
+                  << " added, " << removed << " removed rows (alpha " << std::setprecision(3) << alpha << ", threshold "
+                  << std::setprecision(1) << threshold * 100.0 << "%)\n";
+        return slower > 0 || changed > 0 ? 1 : 0;
+
+    } catch (const std::exception &e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 2;
+    }
+}
@@ -0,0 +1,208 @@
+// Cross-check the day 2 engines against each other: the multiply-and-compare
+// tests against the digits as a string, and the closed-form sums and the
+// vectorized scan (at every ISA level the host supports) against summing
+// the tests over each ID.
+//
+//   aoc_day02_check [--seed=S] [--windows=N]
+//
+// For every digit count from 1 to 20 it checks the whole decade when that is
+// small, N random windows (default 200), windows centred on invalid IDs of
+// each period, and windows across the decade edges, up to the top of
+// uint64. Exit status: 0 all agree, 1 a mismatch, 2 usage error.
+
+#include "aoc.hpp"
+#include "days/day02.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+using day02::Range;
+
+constexpr int max_digits = 20;
+constexpr std::uint64_t window = 4'096;           // width of one random window
+constexpr std::uint64_t full_decade = 1'000'000;  // decades up to this size are checked whole
+
+// The original string forms of the tests.
+bool string_invalid(std::uint64_t value, bool any_period) {
+    const std::string s = std::to_string(value);
+    for (std::size_t period = 1; period < s.size(); ++period) {
+        if (s.size() % period != 0 || (!any_period && period * 2 != s.size())) {
+            continue;
+        }
+        bool repeats = true;
+        for (std::size_t i = period; i < s.size() && repeats; ++i) {
+            repeats = s[i] == s[i - period];
+        }
+        if (repeats) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::uint64_t pow10(int digits) {
+    std::uint64_t p = 1;
+    for (int i = 0; i < digits; ++i) {
+        p *= 10;
+    }
+    return p;
+}
+
+// Last value with `digits` digits, clamped to the type.
+std::uint64_t decade_last(int digits) {
+    return digits == max_digits ? std::numeric_limits<std::uint64_t>::max() : pow10(digits) - 1;
+}
+
+// [center - half, center + half], clamped to the type.
+Range around(std::uint64_t center, std::uint64_t half) {
+    const std::uint64_t top = std::numeric_limits<std::uint64_t>::max();
+    return {center > half ? center - half : 0, center < top - half ? center + half : top};
+}
+
+struct Checker {
+    std::vector<aoc::Isa> isas;
+    std::size_t ranges{0};
+    std::size_t values{0};
+    std::size_t unchecked{0};  // closed form threw: the sum is past a long long
+    std::size_t mismatches{0};
+
+    void report(std::string_view what, Range range, std::uint64_t want, std::uint64_t got) {
+        if (++mismatches <= 20) {
+            std::cerr << what << " [" << range.start << ", " << range.end << "]: expected " << want << ", got "
+                      << got << "\n";
+        }
+    }
+
+    void check_closed(std::string_view what, long long (*closed)(Range), Range range, std::uint64_t want) {
+        try {
+            const auto got = static_cast<std::uint64_t>(closed(range));
+            if (got != want) {
+                report(what, range, want, got);
+            }
+        } catch (const std::runtime_error &) {
+            ++unchecked;
+        }
+    }
+
+    void check(Range range) {
+        ++ranges;
+        std::uint64_t sum1 = 0;  // wrapping, like the scan
+        std::uint64_t sum2 = 0;
+        for (std::uint64_t v = range.start;; ++v) {
+            const bool invalid1 = day02::is_invalid(v);
+            const bool invalid2 = day02::is_invalid_part2(v);
+            if (invalid1 != string_invalid(v, false)) {
+                report("is_invalid", {v, v}, string_invalid(v, false), invalid1);
+            }
+            if (invalid2 != string_invalid(v, true)) {
+                report("is_invalid_part2", {v, v}, string_invalid(v, true), invalid2);
+            }
+            sum1 += invalid1 ? v : 0;
+            sum2 += invalid2 ? v : 0;
+            ++values;
+            if (v == range.end) {
+                break;
+            }
+        }
+
+        check_closed("invalid_sum", &day02::invalid_sum, range, sum1);
+        check_closed("invalid_sum_part2", &day02::invalid_sum_part2, range, sum2);
+        for (const auto isa : isas) {
+            const std::string suffix = std::string(" (") + aoc::isa_name(isa) + ")";
+            const auto got1 = day02::scan_invalid_sum(range, isa);
+            if (got1 != sum1) {
+                report("scan_invalid_sum" + suffix, range, sum1, got1);
+            }
+            const auto got2 = day02::scan_invalid_sum_part2(range, isa);
+            if (got2 != sum2) {
+                report("scan_invalid_sum_part2" + suffix, range, sum2, got2);
+            }
+        }
+    }
+};
+
+std::uint64_t parse_count(std::string_view flag, std::string_view text) {
+    try {
+        return aoc::parse<std::uint64_t>(text);
+    } catch (const std::exception &) {
+        throw std::runtime_error(std::string(flag) + " must be a non-negative integer: " + std::string(text));
+    }
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    std::uint64_t seed = 1;
+    std::uint64_t windows = 200;
+
+    Checker checker;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view arg{argv[i]};
+            if (arg.starts_with("--seed=")) {
+                seed = parse_count("--seed", arg.substr(7));
+            } else if (arg.starts_with("--windows=")) {
+                windows = parse_count("--windows", arg.substr(10));
+            } else {
+                throw std::runtime_error("usage: aoc_day02_check [--seed=S] [--windows=N]");
+            }
+        }
+    } catch (const std::exception &e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 2;
+    }
+
+    for (int isa = 0; isa <= static_cast<int>(aoc::host_isa()); ++isa) {
+        checker.isas.push_back(static_cast<aoc::Isa>(isa));
+    }
+
+    std::mt19937_64 rng(seed);
+    for (int digits = 1; digits <= max_digits; ++digits) {
+        const std::uint64_t first = digits == 1 ? 0 : pow10(digits - 1);
+        const std::uint64_t last = decade_last(digits);
+        if (last - first < full_decade) {
+            checker.check({first, last});
+        }
+
+        for (std::uint64_t w = 0; w < windows; ++w) {
+            const std::uint64_t start = first + rng() % (last - first + 1);
+            checker.check({start, start + std::min<std::uint64_t>(window - 1, last - start)});
+        }
+
+        // Invalid IDs are sparse: centre windows on a random one of each period
+        for (int period = 1; period < digits; ++period) {
+            if (digits % period != 0) {
+                continue;
+            }
+            std::uint64_t repunit = 0;
+            for (int i = 0; i < digits; i += period) {
+                repunit += pow10(i);
+            }
+            const std::uint64_t block_first = pow10(period - 1);
+            const std::uint64_t block_last = std::min(pow10(period) - 1, last / repunit);
+            for (int k = 0; k < 8; ++k) {
+                const std::uint64_t block = block_first + rng() % (block_last - block_first + 1);
+                checker.check(around(block * repunit, window / 2));
+            }
+        }
+
+        // Across the decade edges, so one range spans two digit counts
+        checker.check(around(first, window / 2));
+        checker.check(around(last, window / 2));
+    }
+
+    std::cout << checker.ranges << " ranges, " << checker.values << " IDs, " << checker.isas.size()
+              << " ISA levels (up to " << aoc::isa_name(checker.isas.back()) << "), " << checker.unchecked
+              << " closed-form sums past a long long, " << checker.mismatches << " mismatches\n";
+    return checker.mismatches > 0 ? 1 : 0;
+}
@@ -0,0 +1,449 @@
+// Empirical complexity of every day: synthesize inputs of geometrically
+// growing size with the aoc_gen generators, time each stage, and fit the
+// exponent of the observed growth.
+//
+//   aoc_scaling [DAY|FIRST-LAST|all ...] [--budget=MS] [--seed=S] [harness flags]
+//
+// n doubles until a stage takes longer than --budget (default 1000 ms) or the
+// day's size cap is reached. Each point runs in a forked child, so peak RSS
+// covers that one size and a crash (the recursive solvers overflow the stack
+// on huge inputs) or a runaway stage only ends that day's sweep. The thread
+// pool defaults to one thread here so the pool does not bend the exponent;
+// --threads=N or AOC_THREADS still override it.
+
+#include "aoc/day.hpp"
+#include "generators.hpp"
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace aoc;
+
+namespace {
+
+// How one day is swept. n is the generator's --size.
+struct Sweep {
+    std::uint64_t first;    // first n
+    std::uint64_t last;     // never generate beyond this n
+    unsigned parts;         // parts to run, as for DayEntry::solve
+    std::string_view unit;  // what n counts
+};
+
+constexpr std::array<Sweep, gen::generator_days> sweeps{{
+    {1'000, std::uint64_t{1} << 26, all_parts, "rotations"},
+    {8, std::uint64_t{1} << 20, all_parts, "ranges"},
+    {50, std::uint64_t{1} << 22, all_parts, "banks of 100 digits"},
+    {16, std::uint64_t{1} << 14, all_parts, "grid side"},
+    {250, std::uint64_t{1} << 24, all_parts, "IDs"},
+    {250, std::uint64_t{1} << 22, all_parts, "problems"},
+    {16, 1'024, all_parts, "grid side"},  // recursive beam walk, one frame per row
+    {125, std::uint64_t{1} << 15, all_parts, "junction boxes"},
+    {64, std::uint64_t{1} << 20, all_parts, "polygon vertices"},
+    {20, std::uint64_t{1} << 20, all_parts, "machines"},
+    {100, std::uint64_t{1} << 15, all_parts, "devices"},  // recursive path count, one frame per device
+    {125, std::uint64_t{1} << 22, 0b01, "regions"},  // the last day has one part
+}};
+
+// Stages faster than this are mostly timer noise and stay out of the fit
+// unless nothing else is left.
+constexpr long long min_fit_micros = 100;
+
+struct ScalingOptions {
+    std::uint64_t budget_ms{1'000};
+    std::uint64_t seed{2025};
+    std::vector<int> days;  // empty = every day with a generator
+};
+
+struct Stage {
+    std::string name;  // "parse", "part1", "part2"
+    long long micros{0};
+};
+
+struct Point {
+    std::uint64_t n{0};
+    std::uintmax_t input_bytes{0};
+    std::vector<Stage> stages;
+    std::uint64_t peak_rss_bytes{0};
+    std::string failure;  // why the child did not finish; empty on success
+};
+
+// "5", "1-9" or "all"
+void add_days(std::vector<int> &days, std::string_view arg) {
+    if (arg == "all") {
+        for (int day = 1; day <= gen::generator_days; ++day) {
+            days.push_back(day);
+        }
+        return;
+    }
+    const auto dash = arg.find('-');
+    const int first = parse<int>(arg.substr(0, dash));
+    const int last = dash == std::string_view::npos ? first : parse<int>(arg.substr(dash + 1));
+    if (last < first) {
+        throw std::runtime_error("empty day range: " + std::string(arg));
+    }
+    for (int day = first; day <= last; ++day) {
+        days.push_back(day);
+    }
+}
+
+// Strip the tool's own flags and day selectors; the harness flags are left
+// in argv for aoc::init.
+ScalingOptions parse_scaling_args(int &argc, char **argv) {
+    ScalingOptions opts;
+    int kept = 1;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg{argv[i]};
+        if (arg.starts_with("--budget=")) {
+            opts.budget_ms = parse<std::uint64_t>(arg.substr(9));
+            if (opts.budget_ms == 0) {
+                throw std::runtime_error("--budget must be positive");
+            }
+        } else if (arg.starts_with("--seed=")) {
+            opts.seed = parse<std::uint64_t>(arg.substr(7));
+        } else if (!arg.starts_with("--")) {
+            add_days(opts.days, arg);
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    argc = kept;
+    argv[argc] = nullptr;
+    return opts;
+}
+
+// Child side of a point: solve, send "stage micros" lines up the pipe and
+// exit without running the parent's atexit handlers.
+[[noreturn]] void run_child(const DayEntry &entry, const std::filesystem::path &path, unsigned parts, int fd,
+                            unsigned timeout_seconds) {
+    std::string message;
+    int status = EXIT_SUCCESS;
+    try {
+        // Some days print progress lines of their own.
+        if (!std::freopen("/dev/null", "w", stdout)) {
+            throw std::runtime_error("cannot silence stdout");
+        }
+        alarm(timeout_seconds);
+        MappedInput input(path);
+        const auto result = entry.solve(input.lines(), parts);
+
+        std::ostringstream os;
+        os << "parse " << result.parse.micros << '\n';
+        for (const auto &p : result.parts) {
+            os << "part" << p.part << ' ' << p.timing.micros << '\n';
+        }
+        message = os.str();
+    } catch (const std::exception &e) {
+        message = std::string("error ") + e.what() + '\n';
+        status = EXIT_FAILURE;
+    }
+    const char *data = message.data();
+    std::size_t left = message.size();
+    while (left > 0) {
+        const ssize_t written = write(fd, data, left);
+        if (written <= 0) {
+            break;
+        }
+        data += written;
+        left -= static_cast<std::size_t>(written);
+    }
+    _exit(status);
+}
+
+std::string describe_signal(int sig) {
+    switch (sig) {
+        case SIGSEGV: return "crashed (SIGSEGV, likely stack overflow)";
+        case SIGALRM: return "timed out";
+        case SIGKILL: return "killed (out of memory?)";
+        default: return std::string("killed by signal ") + std::to_string(sig);
+    }
+}
+
+Point run_point(const DayEntry &entry, const std::filesystem::path &path, unsigned parts,
+                unsigned timeout_seconds) {
+    Point point;
+    point.input_bytes = std::filesystem::file_size(path);
+
+    int fds[2];
+    if (pipe(fds) != 0) {
+        throw std::runtime_error(std::string("pipe failed: ") + std::strerror(errno));
+    }
+    std::cout.flush();
+    const pid_t pid = fork();
+    if (pid < 0) {
+        throw std::runtime_error(std::string("fork failed: ") + std::strerror(errno));
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        run_child(entry, path, parts, fds[1], timeout_seconds);
+    }
+    close(fds[1]);
+
+    std::string report;
+    std::array<char, 4096> buf{};
+    ssize_t got = 0;
+    while ((got = read(fds[0], buf.data(), buf.size())) > 0) {
+        report.append(buf.data(), static_cast<std::size_t>(got));
+    }
+    close(fds[0]);
+
+    int status = 0;
+    rusage usage{};
+    if (wait4(pid, &status, 0, &usage) != pid) {
+        throw std::runtime_error(std::string("wait4 failed: ") + std::strerror(errno));
+    }
+    point.peak_rss_bytes = static_cast<std::uint64_t>(usage.ru_maxrss) * 1024;  // KiB on Linux
+
+    std::istringstream is(report);
+    std::string name;
+    while (is >> name) {
+        if (name == "error") {
+            std::getline(is >> std::ws, point.failure);
+            break;
+        }
+        Stage stage{name, 0};
+        is >> stage.micros;
+        point.stages.push_back(stage);
+    }
+
+    if (WIFSIGNALED(status)) {
+        point.failure = describe_signal(WTERMSIG(status));
+    } else if (point.failure.empty() && (!WIFEXITED(status) || WEXITSTATUS(status) != 0)) {
+        point.failure = "exited with status " + std::to_string(WEXITSTATUS(status));
+    }
+    return point;
+}
+
+// Least-squares slope of log(micros) against log(n).
+std::optional<double> fit_exponent(const std::vector<Point> &points, const std::string &stage) {
+    std::vector<std::pair<double, double>> all;
+    for (const auto &point : points) {
+        for (const auto &s : point.stages) {
+            if (s.name == stage && s.micros > 0) {
+                all.emplace_back(static_cast<double>(point.n), static_cast<double>(s.micros));
+            }
+        }
+    }
+    std::vector<std::pair<double, double>> xy;
+    for (const auto &[n, micros] : all) {
+        if (micros >= static_cast<double>(min_fit_micros)) {
+            xy.emplace_back(std::log(n), std::log(micros));
+        }
+    }
+    if (xy.size() < 2) {
+        if (all.size() < 2) {
+            return std::nullopt;
+        }
+        xy.clear();
+        for (std::size_t i = all.size() - 2; i < all.size(); ++i) {
+            xy.emplace_back(std::log(all[i].first), std::log(all[i].second));
+        }
+    }
+
+    double sx = 0, sy = 0;
+    for (const auto &[x, y] : xy) {
+        sx += x;
+        sy += y;
+    }
+    const double count = static_cast<double>(xy.size());
+    const double mx = sx / count, my = sy / count;
+    double sxx = 0, sxy = 0;
+    for (const auto &[x, y] : xy) {
+        sxx += (x - mx) * (x - mx);
+        sxy += (x - mx) * (y - my);
+    }
+    if (sxx == 0) {
+        return std::nullopt;
+    }
+    return sxy / sxx;
+}
+
+// 20k, 1.5M
+std::string short_count(std::uint64_t n) {
+    std::array<char, 32> buf{};
+    if (n >= 1'000'000) {
+        std::snprintf(buf.data(), buf.size(), "%.3gM", static_cast<double>(n) / 1e6);
+    } else if (n >= 1'000) {
+        std::snprintf(buf.data(), buf.size(), "%.3gk", static_cast<double>(n) / 1e3);
+    } else {
+        std::snprintf(buf.data(), buf.size(), "%llu", static_cast<unsigned long long>(n));
+    }
+    return buf.data();
+}
+
+// 1.8 GB, 512 KB
+std::string short_bytes(std::uintmax_t bytes) {
+    constexpr std::array<std::string_view, 5> units{"B", "KB", "MB", "GB", "TB"};
+    double value = static_cast<double>(bytes);
+    std::size_t unit = 0;
+    while (value >= 1024.0 && unit + 1 < units.size()) {
+        value /= 1024.0;
+        ++unit;
+    }
+    std::array<char, 32> buf{};
+    std::snprintf(buf.data(), buf.size(), unit == 0 ? "%.0f %s" : "%.1f %s", value, units[unit].data());
+    return buf.data();
+}
+
+std::vector<std::string> stage_names(unsigned parts) {
+    std::vector<std::string> names{"parse"};
+    for (int part = 1; part <= 2; ++part) {
+        if (parts & (1U << (part - 1))) {
+            names.push_back("part" + std::to_string(part));
+        }
+    }
+    return names;
+}
+
+void print_point(const Point &point, const std::vector<std::string> &names) {
+    std::cout << std::setw(10) << point.n << std::setw(11) << short_bytes(point.input_bytes);
+    for (const auto &name : names) {
+        const auto it = std::find_if(point.stages.begin(), point.stages.end(),
+                                     [&](const Stage &s) { return s.name == name; });
+        if (it != point.stages.end()) {
+            std::cout << std::setw(12) << it->micros;
+        } else {
+            std::cout << std::setw(12) << "-";
+        }
+    }
+    std::cout << std::setw(11) << short_bytes(point.peak_rss_bytes);
+    if (!point.failure.empty()) {
+        std::cout << "  " << point.failure;
+    }
+    std::cout << "\n";
+}
+
+// Sweep one day and return its summary lines.
+std::vector<std::string> sweep_day(int day, const ScalingOptions &opts) {
+    const DayEntry *entry = find_day(day);
+    if (!entry) {
+        throw std::runtime_error("day " + std::to_string(day) + " is not linked into aoc_scaling");
+    }
+    const auto &sweep = sweeps[static_cast<std::size_t>(day - 1)];
+    const auto names = stage_names(sweep.parts);
+    const auto budget_micros = static_cast<long long>(opts.budget_ms * 1'000);
+    // Generous: the budget check only runs between points.
+    const auto timeout = static_cast<unsigned>(std::max<std::uint64_t>(10, opts.budget_ms / 50));
+
+    std::ostringstream file_name;
+    file_name << "aoc_scaling_" << getpid() << "_day" << std::setw(2) << std::setfill('0') << day << ".txt";
+    const auto path = std::filesystem::temp_directory_path() / file_name.str();
+
+    std::cout << "day" << std::setw(2) << std::setfill('0') << day << std::setfill(' ') << " (n = " << sweep.unit
+              << ")\n";
+    std::cout << std::setw(10) << "n" << std::setw(11) << "input";
+    for (const auto &name : names) {
+        std::cout << std::setw(12) << (name + " us");
+    }
+    std::cout << std::setw(11) << "peak RSS" << "\n";
+
+    std::vector<Point> points;
+    std::string stop_reason = "size cap";
+    for (std::uint64_t n = sweep.first; n <= sweep.last; n *= 2) {
+        std::FILE *out = std::fopen(path.c_str(), "wb");
+        if (!out) {
+            throw std::runtime_error("cannot open scratch file: " + path.string());
+        }
+        try {
+            gen::generate(day, gen::resolve(day, {.size = n}), opts.seed, out);
+        } catch (...) {
+            std::fclose(out);
+            std::filesystem::remove(path);
+            throw;
+        }
+        if (std::fclose(out) != 0) {
+            std::filesystem::remove(path);
+            throw std::runtime_error("cannot write scratch file: " + path.string());
+        }
+
+        Point point = run_point(*entry, path, sweep.parts, timeout);
+        std::filesystem::remove(path);
+        point.n = n;
+        print_point(point, names);
+
+        if (!point.failure.empty()) {
+            stop_reason = point.failure;
+            break;
+        }
+        points.push_back(std::move(point));
+        const auto &last = points.back();
+        if (std::any_of(last.stages.begin(), last.stages.end(),
+                        [&](const Stage &s) { return s.micros > budget_micros; })) {
+            stop_reason = "time budget";
+            break;
+        }
+    }
+    std::cout << "stopped: " << stop_reason << "\n\n";
+
+    std::vector<std::string> summary;
+    for (const auto &name : names) {
+        std::ostringstream line;
+        line << "day" << std::setw(2) << std::setfill('0') << day << ' ' << name << ": ";
+        const auto exponent = fit_exponent(points, name);
+        if (exponent && !points.empty()) {
+            line << "~n^" << std::fixed << std::setprecision(1) << *exponent << ", "
+                 << short_bytes(points.back().peak_rss_bytes) << " at n=" << short_count(points.back().n);
+        } else {
+            line << "n/a (too few points)";
+        }
+        line << " (n = " << sweep.unit << ")";
+        summary.push_back(line.str());
+    }
+    return summary;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    try {
+        auto opts = parse_scaling_args(argc, argv);
+        options().threads = 1;
+        init(argc, argv);
+        if (options().format != OutputFormat::text) {
+            throw std::runtime_error("aoc_scaling only prints text");
+        }
+        if (argc > 1) {
+            throw std::runtime_error("unexpected argument: " + std::string(argv[1]));
+        }
+        if (opts.days.empty()) {
+            add_days(opts.days, "all");
+        }
+
+        std::vector<std::string> summary;
+        for (const int day : opts.days) {
+            if (day < 1 || day > gen::generator_days) {
+                throw std::runtime_error("no generator for day " + std::to_string(day));
+            }
+            const auto lines = sweep_day(day, opts);
+            summary.insert(summary.end(), lines.begin(), lines.end());
+        }
+
+        std::cout << "Scaling (time exponent, peak RSS at the largest n)\n";
+        for (const auto &line : summary) {
+            std::cout << line << "\n";
+        }
+
+    } catch (const std::exception &e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,484 @@
+#include "generators.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace aoc::gen {
+
+namespace {
+
+class Rng {
+public:
+    explicit Rng(std::uint64_t seed) : state_(seed) {}
+
+    std::uint64_t next() noexcept {
+        std::uint64_t z = (state_ += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform in [lo, hi] (inclusive); the modulo bias is negligible for
+    // the small spans used here.
+    std::uint64_t between(std::uint64_t lo, std::uint64_t hi) noexcept {
+        const std::uint64_t span = hi - lo + 1;
+        return span == 0 ? next() : lo + next() % span;
+    }
+
+    // True with probability num/den.
+    bool chance(std::uint64_t num, std::uint64_t den) noexcept { return between(1, den) <= num; }
+
+private:
+    std::uint64_t state_;
+};
+
+// Buffered writer; large inputs are hundreds of MB.
+class Writer {
+public:
+    explicit Writer(std::FILE *out) : out_(out) { buf_.reserve(capacity); }
+    // Only reached without flush() when generation threw; the first error
+    // is already on its way, so a failed write here is not reported.
+    ~Writer() {
+        if (!buf_.empty()) {
+            static_cast<void>(std::fwrite(buf_.data(), 1, buf_.size(), out_));
+        }
+    }
+
+    Writer(const Writer &) = delete;
+    Writer &operator=(const Writer &) = delete;
+
+    Writer &operator<<(std::string_view s) {
+        buf_.append(s);
+        if (buf_.size() >= capacity) {
+            flush();
+        }
+        return *this;
+    }
+    Writer &operator<<(char c) { return *this << std::string_view{&c, 1}; }
+    Writer &operator<<(std::uint64_t v) { return *this << std::string_view{std::to_string(v)}; }
+
+    // Throws std::runtime_error on a short write; call it once generation
+    // is done.
+    void flush() {
+        if (!buf_.empty() && std::fwrite(buf_.data(), 1, buf_.size(), out_) != buf_.size()) {
+            throw std::runtime_error("write failed");
+        }
+        buf_.clear();
+    }
+
+private:
+    static constexpr std::size_t capacity = std::size_t{1} << 20;
+    std::FILE *out_;
+    std::string buf_;
+};
+
+using Generator = void (*)(Writer &, Rng &, const GenOptions &);
+
+// ---------- days ----------
+
+// size = rotations, one "L42"/"R7" per line
+void gen_day01(Writer &w, Rng &rng, const GenOptions &o) {
+    for (std::uint64_t i = 0; i < o.size; ++i) {
+        w << (rng.chance(1, 2) ? 'L' : 'R') << rng.between(1, 999) << '\n';
+    }
+}
+
+// size = ranges on one comma-separated line; bounds stay below 2^32
+void gen_day02(Writer &w, Rng &rng, const GenOptions &o) {
+    for (std::uint64_t i = 0; i < o.size; ++i) {
+        const std::uint64_t digits = rng.between(1, 9);
+        std::uint64_t lo = 1;
+        for (std::uint64_t d = 1; d < digits; ++d) {
+            lo *= 10;
+        }
+        const std::uint64_t start = rng.between(lo, lo * 10 - 1);
+        const std::uint64_t end = start + rng.between(0, std::min<std::uint64_t>(lo, 100'000));
+        w << (i == 0 ? "" : ",") << start << '-' << end;
+    }
+    w << '\n';
+}
+
+// size = banks of `width` digits 1-9
+void gen_day03(Writer &w, Rng &rng, const GenOptions &o) {
+    for (std::uint64_t i = 0; i < o.size; ++i) {
+        for (std::uint64_t c = 0; c < o.width; ++c) {
+            w << static_cast<char>('0' + rng.between(1, 9));
+        }
+        w << '\n';
+    }
+}
+
+// width x height grid of '@' rolls (about two thirds) and '.'
+void gen_day04(Writer &w, Rng &rng, const GenOptions &o) {
+    for (std::uint64_t r = 0; r < o.height; ++r) {
+        for (std::uint64_t c = 0; c < o.width; ++c) {
+            w << (rng.chance(2, 3) ? '@' : '.');
+        }
+        w << '\n';
+    }
+}
+
+// size = IDs to check, after size/5 + 1 fresh ranges and a blank line
+void gen_day05(Writer &w, Rng &rng, const GenOptions &o) {
+    constexpr std::uint64_t max_id = 500'000'000'000'000ULL;
+    const std::uint64_t ranges = o.size / 5 + 1;
+    for (std::uint64_t i = 0; i < ranges; ++i) {
+        const std::uint64_t start = rng.between(1, max_id);
+        w << start << '-' << start + rng.between(0, max_id / 500) << '\n';
+    }
+    w << '\n';
+    for (std::uint64_t i = 0; i < o.size; ++i) {
+        w << rng.between(1, max_id) << '\n';
+    }
+}
+
+// size = problems (columns); height = number rows (default 4), then the
+// operator row. Each column is as wide as its widest number and numbers are
+// padded left or right at random, like the real worksheet. Up to 3 digits
+// keeps the products inside 64 bits.
+void gen_day06(Writer &w, Rng &rng, const GenOptions &o) {
+    const std::uint64_t rows = o.height;
+    std::vector<std::vector<std::string>> cells(rows, std::vector<std::string>(o.size));
+    std::vector<std::size_t> widths(o.size);
+    std::string ops(o.size, '+');
+
+    for (std::uint64_t c = 0; c < o.size; ++c) {
+        const std::uint64_t digits = rng.between(1, 3);
+        const bool left = rng.chance(1, 2);
+        std::uint64_t hi = 1;
+        for (std::uint64_t d = 0; d < digits; ++d) {
+            hi *= 10;
+        }
+        std::vector<std::string> nums(rows);
+        for (std::uint64_t r = 0; r < rows; ++r) {
+            nums[r] = std::to_string(rng.between(1, hi - 1));
+            widths[c] = std::max(widths[c], nums[r].size());
+        }
+        for (std::uint64_t r = 0; r < rows; ++r) {
+            const std::string pad(widths[c] - nums[r].size(), ' ');
+            cells[r][c] = left ? nums[r] + pad : pad + nums[r];
+        }
+        ops[c] = rng.chance(1, 2) ? '*' : '+';
+    }
+
+    for (std::uint64_t r = 0; r < rows; ++r) {
+        for (std::uint64_t c = 0; c < o.size; ++c) {
+            w << (c == 0 ? "" : " ") << cells[r][c];
+        }
+        w << '\n';
+    }
+    for (std::uint64_t c = 0; c < o.size; ++c) {
+        w << (c == 0 ? "" : " ") << ops[c] << std::string(widths[c] - 1, ' ');
+    }
+    w << '\n';
+}
+
+// width x height manifold: 'S' centred in the top row, '^' splitters on
+// every other row from the third one on, never side by side (the solver
+// would bounce a ray between two adjacent splitters forever)
+void gen_day07(Writer &w, Rng &rng, const GenOptions &o) {
+    for (std::uint64_t r = 0; r < o.height; ++r) {
+        char prev = '.';
+        for (std::uint64_t c = 0; c < o.width; ++c) {
+            char ch = '.';
+            if (r == 0 && c == o.width / 2) {
+                ch = 'S';
+            } else if (r >= 2 && r % 2 == 0 && c > 0 && c + 1 < o.width && prev != '^' && rng.chance(1, 6)) {
+                ch = '^';
+            }
+            w << ch;
+            prev = ch;
+        }
+        w << '\n';
+    }
+}
+
+// size = junction boxes "x,y,z" with coordinates below 100000
+void gen_day08(Writer &w, Rng &rng, const GenOptions &o) {
+    for (std::uint64_t i = 0; i < o.size; ++i) {
+        w << rng.between(0, 99'999) << ',' << rng.between(0, 99'999) << ',' << rng.between(0, 99'999) << '\n';
+    }
+}
+
+// size = vertices of a closed rectilinear polygon "x,y", listed in order.
+// The top edge is a staircase walked left to right, the bottom one right to
+// left, so consecutive vertices always share an x or a y.
+void gen_day09(Writer &w, Rng &rng, const GenOptions &o) {
+    const std::uint64_t steps = std::max<std::uint64_t>(1, o.size / 4);  // 4 * steps vertices
+    constexpr std::uint64_t mid = 1'000'000;
+    constexpr std::uint64_t amplitude = 500'000;
+
+    const auto profile = [&](bool top) {
+        std::vector<std::uint64_t> xs(steps + 1);
+        std::vector<std::uint64_t> ys(steps);
+        std::uint64_t x = 1;
+        for (std::uint64_t i = 0; i <= steps; ++i) {
+            xs[i] = x;
+            x += rng.between(1, 20);
+        }
+        for (std::uint64_t i = 0; i < steps; ++i) {
+            do {
+                ys[i] = top ? mid + rng.between(1, amplitude) : mid - rng.between(1, amplitude);
+            } while (i > 0 && ys[i] == ys[i - 1]);
+        }
+        return std::pair{xs, ys};
+    };
+
+    auto [top_x, top_y] = profile(true);
+    auto [bot_x, bot_y] = profile(false);
+    // Both staircases must end on the same vertical edge.
+    top_x.back() = bot_x.back() = std::max(top_x.back(), bot_x.back());
+
+    const auto point = [&](std::uint64_t x, std::uint64_t y) { w << x << ',' << y << '\n'; };
+    for (std::uint64_t i = 0; i < steps; ++i) {
+        point(top_x[i], top_y[i]);
+        point(top_x[i + 1], top_y[i]);
+    }
+    for (std::uint64_t i = steps; i-- > 0;) {
+        point(bot_x[i + 1], bot_y[i]);
+        point(bot_x[i], bot_y[i]);
+    }
+}
+
+// size = machines "[pattern] (groups) {targets}". Pattern and targets come
+// from random button presses, so every row is solvable. Part 2 searches
+// every press count per button, so rows keep to at most 8 buttons pressed
+// at most 3 times each. With up to 13 buttons and 20 presses, five rows
+// already ran for over a minute.
+void gen_day10(Writer &w, Rng &rng, const GenOptions &o) {
+    constexpr std::uint64_t max_buttons = 8;
+    constexpr std::uint64_t max_presses = 3;
+    for (std::uint64_t i = 0; i < o.size; ++i) {
+        const std::uint64_t lights = rng.between(4, 10);
+        const std::uint64_t buttons = std::min(max_buttons, rng.between(lights - 2, lights + 3));
+
+        std::vector<std::vector<std::uint64_t>> groups(buttons);
+        for (auto &g : groups) {
+            const std::uint64_t n = rng.between(1, std::min<std::uint64_t>(lights, 5));
+            while (g.size() < n) {
+                const std::uint64_t light = rng.between(0, lights - 1);
+                if (std::find(g.begin(), g.end(), light) == g.end()) {
+                    g.push_back(light);
+                }
+            }
+            std::sort(g.begin(), g.end());
+        }
+
+        std::string pattern(lights, '.');
+        std::vector<std::uint64_t> targets(lights, 0);
+        for (const auto &g : groups) {
+            if (rng.chance(1, 2)) {
+                for (const auto light : g) {
+                    pattern[light] = pattern[light] == '.' ? '#' : '.';
+                }
+            }
+            const std::uint64_t presses = rng.between(0, max_presses);
+            for (const auto light : g) {
+                targets[light] += presses;
+            }
+        }
+
+        w << '[' << pattern << ']';
+        for (const auto &g : groups) {
+            w << " (";
+            for (std::size_t k = 0; k < g.size(); ++k) {
+                w << (k == 0 ? "" : ",") << g[k];
+            }
+            w << ')';
+        }
+        w << " {";
+        for (std::size_t k = 0; k < targets.size(); ++k) {
+            w << (k == 0 ? "" : ",") << targets[k];
+        }
+        w << "}\n";
+    }
+}
+
+// size = devices (at least 100) of a DAG "abc: def ghi", with "svr", "fft",
+// "dac", "you" and "out" placed along one chain so every required path exists. Names grow past
+// three letters once 26^3 is used up. Path counts grow exponentially with
+// size and wrap around 64 bits on large graphs.
+void gen_day11(Writer &w, Rng &rng, const GenOptions &o) {
+    const std::uint64_t n = std::max<std::uint64_t>(o.size, 100);
+    constexpr std::array<std::string_view, 5> reserved{"svr", "you", "fft", "dac", "out"};
+
+    std::vector<std::string> names(n);
+    names[0] = "svr";
+    // Part 1 enumerates every path without memoization, so "you" sits
+    // close to "out" like in the real input.
+    names[n - 25] = "you";
+    names[n / 3 + 1] = "fft";
+    names[2 * n / 3 + 1] = "dac";
+    names[n - 1] = "out";
+
+    std::uint64_t serial = 0;
+    for (auto &name : names) {
+        while (name.empty()) {
+            std::string candidate;
+            std::uint64_t v = serial++;
+            do {
+                candidate.insert(candidate.begin(), static_cast<char>('a' + v % 26));
+                v /= 26;
+            } while (v != 0 || candidate.size() < 3);
+            if (std::find(reserved.begin(), reserved.end(), candidate) == reserved.end()) {
+                name = std::move(candidate);
+            }
+        }
+    }
+
+    // Children always come later in the order; the i -> i+1 edge keeps the
+    // whole chain connected.
+    constexpr std::uint64_t window = 32;
+    std::vector<std::uint64_t> children;
+    for (std::uint64_t i = 0; i + 1 < n; ++i) {
+        children.assign(1, i + 1);
+        const std::uint64_t extra = rng.between(0, 2);
+        for (std::uint64_t k = 0; k < extra; ++k) {
+            const std::uint64_t child = rng.between(i + 1, std::min(n - 1, i + window));
+            if (std::find(children.begin(), children.end(), child) == children.end()) {
+                children.push_back(child);
+            }
+        }
+        w << names[i] << ':';
+        for (const auto child : children) {
+            w << ' ' << names[child];
+        }
+        w << '\n';
+    }
+}
+
+// six 3x3 presents, then size = regions "WxH: c0 c1 ... c5" whose present
+// area lands between 75% and 105% of the region area
+void gen_day12(Writer &w, Rng &rng, const GenOptions &o) {
+    constexpr std::uint64_t shapes = 6;
+    std::array<std::uint64_t, shapes> areas{};
+    for (std::uint64_t s = 0; s < shapes; ++s) {
+        std::array<bool, 9> cells{};
+        cells[4] = true;
+        std::uint64_t filled = 1;
+        const std::uint64_t target = rng.between(5, 7);
+        while (filled < target) {
+            auto &cell = cells[rng.between(0, 8)];
+            if (!cell) {
+                cell = true;
+                ++filled;
+            }
+        }
+        areas[s] = filled;
+        w << s << ":\n";
+        for (std::size_t r = 0; r < 3; ++r) {
+            for (std::size_t c = 0; c < 3; ++c) {
+                w << (cells[r * 3 + c] ? '#' : '.');
+            }
+            w << '\n';
+        }
+        w << '\n';
+    }
+
+    for (std::uint64_t i = 0; i < o.size; ++i) {
+        const std::uint64_t width = rng.between(35, 50);
+        const std::uint64_t height = rng.between(35, 50);
+        const std::uint64_t budget = width * height * rng.between(75, 105) / 100;
+
+        std::array<std::uint64_t, shapes> counts{};
+        std::uint64_t used = 0;
+        // Hand out presents in bulk, then top up one at a time.
+        const std::uint64_t base = budget / (shapes * 7);
+        for (std::uint64_t s = 0; s < shapes; ++s) {
+            counts[s] = base;
+            used += base * areas[s];
+        }
+        while (true) {
+            const std::uint64_t s = rng.between(0, shapes - 1);
+            if (used + areas[s] > budget) {
+                break;
+            }
+            ++counts[s];
+            used += areas[s];
+        }
+
+        w << width << 'x' << height << ':';
+        for (const auto c : counts) {
+            w << ' ' << c;
+        }
+        w << '\n';
+    }
+}
+
+struct GeneratorEntry {
+    Generator generate;
+    GenOptions defaults;  // sized like the real puzzle inputs
+};
+
+constexpr std::array<GeneratorEntry, generator_days> generators{{
+    {gen_day01, {4'000, 0, 0}},
+    {gen_day02, {40, 0, 0}},
+    {gen_day03, {200, 100, 0}},
+    {gen_day04, {0, 140, 140}},
+    {gen_day05, {1'000, 0, 0}},
+    {gen_day06, {1'000, 0, 4}},
+    {gen_day07, {0, 141, 142}},
+    {gen_day08, {1'000, 0, 0}},
+    {gen_day09, {500, 0, 0}},
+    {gen_day10, {150, 0, 0}},
+    {gen_day11, {600, 0, 0}},
+    {gen_day12, {1'000, 0, 0}},
+}};
+
+const GeneratorEntry &entry(int day) {
+    if (day < 1 || day > generator_days) {
+        throw std::runtime_error("no generator for day " + std::to_string(day));
+    }
+    return generators[static_cast<std::size_t>(day - 1)];
+}
+
+}  // namespace
+
+GenOptions resolve(int day, const GenOptions &given) {
+    const auto &defaults = entry(day).defaults;
+    GenOptions opts = defaults;
+    opts.size = given.size ? given.size : opts.size;
+    opts.width = given.width ? given.width : opts.width;
+    opts.height = given.height ? given.height : opts.height;
+    // Grid days take size as the side length when no shape is given.
+    if (given.size && !given.width && !given.height && defaults.size == 0) {
+        opts.width = opts.height = given.size;
+    }
+    return opts;
+}
+
+void generate(int day, const GenOptions &opts, std::uint64_t seed, std::FILE *out) {
+    Rng rng(seed ^ (static_cast<std::uint64_t>(day) << 56));
+    Writer writer(out);
+    entry(day).generate(writer, rng, opts);
+    writer.flush();
+}
+
+std::string generate_text(int day, const GenOptions &opts, std::uint64_t seed) {
+    char *data = nullptr;
+    std::size_t size = 0;
+    std::FILE *out = open_memstream(&data, &size);
+    if (!out) {
+        throw std::runtime_error("open_memstream failed");
+    }
+    try {
+        generate(day, opts, seed, out);
+    } catch (...) {
+        std::fclose(out);
+        std::free(data);
+        throw;
+    }
+    std::fclose(out);
+    std::string text(data, size);
+    std::free(data);
+    return text;
+}
+
+}  // namespace aoc::gen
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+// Seeded input generators shared by aoc_gen and aoc_scaling. The same day,
+// options and seed always produce the same bytes.
+namespace aoc::gen {
+
+// Days 1..generator_days have a generator.
+inline constexpr int generator_days = 12;
+
+// size is the main count for the day; width/height shape the grid days.
+// Zero means "use the default".
+struct GenOptions {
+    std::uint64_t size{0};
+    std::uint64_t width{0};
+    std::uint64_t height{0};
+};
+
+// Fill the unset fields of `given` with the day's defaults, which are sized
+// like the real puzzle inputs. Grid days take size as the side length.
+// Throws std::runtime_error for a day without a generator.
+GenOptions resolve(int day, const GenOptions &given);
+
+// Write one input for `day` to `out`.
+void generate(int day, const GenOptions &opts, std::uint64_t seed, std::FILE *out);
+
+// The same input, in memory.
+std::string generate_text(int day, const GenOptions &opts, std::uint64_t seed);
+
+}  // namespace aoc::gen